@@ -0,0 +1,47 @@
+#pragma once
+#ifndef PARSE_IT_BENCHMARKS_BENCH_H
+#define PARSE_IT_BENCHMARKS_BENCH_H
+
+/**
+ * Minimal timing helpers shared by the benchmarks.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace parse_it::bench {
+
+// Prevent the compiler from optimizing away a computed value.
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Run f repeatedly and print the best observed throughput.
+ * @param name The name of the benchmark.
+ * @param bytes The number of bytes processed by one call to f.
+ * @param f The function to measure.
+ */
+template <typename F>
+void measure(const char* name, std::size_t bytes, F&& f)
+{
+  constexpr int runs = 20;
+  auto best = std::chrono::nanoseconds::max();
+  for (int run = 0; run < runs; ++run)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+  }
+  const auto ns = static_cast<double>(best.count());
+  std::printf("%-40s %10.0f ns %8.2f GB/s\n", name, ns, static_cast<double>(bytes) / ns);
+}
+
+} // namespace parse_it::bench
+
+#endif
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "parse_it/parser.h"
+
+using namespace parse_it;
+
+namespace {
+
+struct record
+{
+  std::uint32_t id;
+  std::uint16_t size;
+  std::uint8_t flags;
+};
+
+constexpr std::size_t record_size = 7;
+constexpr std::size_t record_count = 1 << 20;
+
+std::vector<std::byte> make_records()
+{
+  auto data = std::vector<std::byte>(record_count * record_size);
+  for (std::size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<std::byte>(i * 31);
+  }
+  return data;
+}
+
+std::uint64_t sum(std::uint64_t acc, const record& r) { return acc + r.id + r.size + r.flags; }
+
+// Reference implementation: a hand written loop over raw pointers.
+std::uint64_t hand_written(parse_input_t input)
+{
+  std::uint64_t acc = 0;
+  auto it = input.data();
+  const auto end = it + input.size();
+  while (static_cast<std::size_t>(end - it) >= record_size)
+  {
+    record r{};
+    std::memcpy(&r.id, it, sizeof(r.id));
+    std::memcpy(&r.size, it + 4, sizeof(r.size));
+    r.flags = std::to_integer<std::uint8_t>(it[6]);
+    acc = sum(acc, r);
+    it += record_size;
+  }
+  return acc;
+}
+
+// The protocol used before cursors: every parser returns optional<pair<T, span>> and combinators build a new span
+// at every stage. Kept here to measure what running parsers on a cursor saves.
+namespace span_protocol {
+
+template <typename T>
+auto arithmetic()
+{
+  return [](parse_input_t input) -> parse_result_t<T> {
+    if (input.size() < sizeof(T))
+    {
+      return std::nullopt;
+    }
+    return std::pair(details::load_arithmetic<T, std::endian::little>(input.data()), input.subspan(sizeof(T)));
+  };
+}
+
+template <typename P>
+auto combiner(P p)
+{
+  return [p](parse_input_t input) -> parse_result_t<std::tuple<details::parsed_t<P>>> {
+    auto r = p(input);
+    if (!r)
+    {
+      return std::nullopt;
+    }
+    return std::pair(std::tuple{r->first}, r->second);
+  };
+}
+
+template <typename P, typename... Ps>
+auto combiner(P p, Ps... ps)
+{
+  return [p, tail = combiner(ps...)](
+           parse_input_t input) -> parse_result_t<std::tuple<details::parsed_t<P>, details::parsed_t<Ps>...>> {
+    auto r = p(input);
+    if (!r)
+    {
+      return std::nullopt;
+    }
+    auto tail_result = tail(r->second);
+    if (!tail_result)
+    {
+      return std::nullopt;
+    }
+    return std::pair(std::tuple_cat(std::tuple{r->first}, tail_result->first), tail_result->second);
+  };
+}
+
+template <typename F, typename... Ps>
+auto combine(F f, Ps... ps)
+{
+  using T = std::invoke_result_t<F, details::parsed_t<Ps>...>;
+  return [f, c = combiner(ps...)](parse_input_t input) -> parse_result_t<T> {
+    auto result = c(input);
+    if (!result)
+    {
+      return std::nullopt;
+    }
+    return std::pair(std::apply(f, result->first), result->second);
+  };
+}
+
+template <typename P, typename T, typename F>
+auto many(P p, T init, F f)
+{
+  return [p, init, f](parse_input_t input) -> parse_result_t<T> {
+    T value = init;
+    while (auto r = p(input))
+    {
+      value = f(std::move(value), r->first);
+      input = r->second;
+    }
+    return std::pair(value, input);
+  };
+}
+
+} // namespace span_protocol
+
+} // namespace
+
+int main()
+{
+  const auto data = make_records();
+  const auto parser = many(
+    combine(
+      [](std::uint32_t id, std::uint16_t size, std::uint8_t flags) { return record{id, size, flags}; },
+      arithmetic_parser<std::uint32_t, std::endian::little>(), arithmetic_parser<std::uint16_t, std::endian::little>(),
+      arithmetic_parser<std::uint8_t>()),
+    std::uint64_t{0}, [](std::uint64_t acc, const record& r) { return sum(acc, r); });
+
+  const auto span_parser = span_protocol::many(
+    span_protocol::combine(
+      [](std::uint32_t id, std::uint16_t size, std::uint8_t flags) { return record{id, size, flags}; },
+      span_protocol::arithmetic<std::uint32_t>(), span_protocol::arithmetic<std::uint16_t>(),
+      span_protocol::arithmetic<std::uint8_t>()),
+    std::uint64_t{0}, [](std::uint64_t acc, const record& r) { return sum(acc, r); });
+
+  bench::measure("hand written loop", data.size(), [&] { bench::do_not_optimize(hand_written(data)); });
+  bench::measure("many(combine(...))", data.size(), [&] { bench::do_not_optimize(parser(data)->first); });
+  bench::measure(
+    "many(combine(...)), span protocol", data.size(), [&] { bench::do_not_optimize(span_parser(data)->first); });
+}
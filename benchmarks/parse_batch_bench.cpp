@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench.h"
+#include "parse_it/batch.h"
+#include "parse_it/parser.h"
+
+using namespace parse_it;
+
+namespace {
+
+struct order
+{
+  std::uint64_t id;
+  std::uint64_t price;
+  std::uint32_t quantity;
+  std::uint8_t side;
+};
+
+constexpr std::size_t message_size = 21;
+// Messages are scattered in a pool much larger than the caches, as datagrams received in different buffers.
+constexpr std::size_t pool_size = std::size_t{256} << 20;
+constexpr std::size_t slot_size = 256;
+constexpr std::size_t message_count = 1 << 18;
+constexpr std::size_t burst_size = 32;
+
+std::vector<std::byte> make_pool()
+{
+  auto pool = std::vector<std::byte>(pool_size);
+  for (std::size_t i = 0; i < pool.size(); ++i)
+  {
+    pool[i] = static_cast<std::byte>(i * 31);
+  }
+  return pool;
+}
+
+std::vector<parse_input_t> make_messages(const std::vector<std::byte>& pool)
+{
+  auto slots = std::vector<std::size_t>(pool_size / slot_size);
+  for (std::size_t i = 0; i < slots.size(); ++i)
+  {
+    slots[i] = i;
+  }
+  std::shuffle(slots.begin(), slots.end(), std::mt19937_64{42});
+  auto messages = std::vector<parse_input_t>(message_count);
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    messages[i] = parse_input_t{pool}.subspan(slots[i] * slot_size, message_size);
+  }
+  return messages;
+}
+
+std::uint64_t sum(const std::vector<order>& orders)
+{
+  std::uint64_t acc = 0;
+  for (const auto& o : orders)
+  {
+    acc += o.id + o.price + o.quantity + o.side;
+  }
+  return acc;
+}
+
+} // namespace
+
+int main()
+{
+  const auto pool = make_pool();
+  const auto messages = make_messages(pool);
+  const auto parser = combine(
+    [](std::uint64_t id, std::uint64_t price, std::uint32_t quantity, std::uint8_t side) {
+      return order{id, price, quantity, side};
+    },
+    arithmetic_parser<std::uint64_t, std::endian::little>(), arithmetic_parser<std::uint64_t, std::endian::little>(),
+    arithmetic_parser<std::uint32_t, std::endian::little>(), arithmetic_parser<std::uint8_t>());
+  auto orders = std::vector<order>(burst_size);
+  const auto bytes = message_count * message_size;
+
+  bench::measure("plain loop", bytes, [&] {
+    for (std::size_t first = 0; first < messages.size(); first += burst_size)
+    {
+      for (std::size_t i = 0; i < burst_size; ++i)
+      {
+        if (auto r = parser(messages[first + i]))
+        {
+          orders[i] = r->first;
+        }
+      }
+      bench::do_not_optimize(sum(orders));
+    }
+  });
+  bench::measure("parse_batch", bytes, [&] {
+    for (std::size_t first = 0; first < messages.size(); first += burst_size)
+    {
+      const auto burst = std::span(messages).subspan(first, burst_size);
+      bench::do_not_optimize(parse_batch(parser, burst, std::span(orders)).first);
+      bench::do_not_optimize(sum(orders));
+    }
+  });
+}
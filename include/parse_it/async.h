@@ -0,0 +1,350 @@
+#pragma once
+#ifndef PARSE_IT_ASYNC_H
+#define PARSE_IT_ASYNC_H
+
+/**
+ * Coroutine based parsing of inputs arriving asynchronously.
+ *
+ * async_parse(source, p) runs p on the bytes available in source and, instead of failing when they are not enough,
+ * suspends until the source delivers more bytes. Each pending parse is a small coroutine frame, so one thread can
+ * drive many connections.
+ *
+ * Parsers do not suspend in the middle of a grammar: the source buffers the bytes of an incomplete message and p is
+ * run again from the first of them on every wake-up. A message delivered in k chunks is thus parsed k times, which
+ * is quadratic in the number of chunks. This is cheap for messages bounded by a small max_size, not for large
+ * messages trickling in byte by byte.
+ *
+ * @see parser.h for more information about parsers.
+ */
+
+#include <array>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "parser_details.h"
+#include "parser_types.h"
+
+namespace parse_it {
+
+namespace details {
+
+/**
+ * Per thread pool of coroutine frames.
+ *
+ * Frames are grouped by size classes of 64 bytes, freed frames are kept in a free list and reused by the next
+ * coroutine of the same class instead of going back to the global allocator. Frames larger than the biggest class
+ * are not pooled.
+ */
+class frame_pool
+{
+  static constexpr std::size_t granularity = 64;
+  static constexpr std::size_t classes = 16;
+
+  struct free_frame
+  {
+    free_frame* next;
+  };
+
+  std::array<free_frame*, classes> free_lists_{};
+
+  static std::size_t class_of(std::size_t size) { return (size - 1) / granularity; }
+
+  frame_pool() = default;
+
+public:
+  frame_pool(const frame_pool&) = delete;
+  frame_pool& operator=(const frame_pool&) = delete;
+
+  ~frame_pool()
+  {
+    for (std::size_t i = 0; i < classes; ++i)
+    {
+      while (auto frame = free_lists_[i])
+      {
+        free_lists_[i] = frame->next;
+        ::operator delete(frame, (i + 1) * granularity);
+      }
+    }
+  }
+
+  static frame_pool& local()
+  {
+    thread_local frame_pool pool;
+    return pool;
+  }
+
+  void* allocate(std::size_t size)
+  {
+    const auto c = class_of(size);
+    if (c >= classes)
+    {
+      return ::operator new(size);
+    }
+    if (auto frame = free_lists_[c])
+    {
+      free_lists_[c] = frame->next;
+      return frame;
+    }
+    return ::operator new((c + 1) * granularity);
+  }
+
+  void deallocate(void* p, std::size_t size)
+  {
+    const auto c = class_of(size);
+    if (c >= classes)
+    {
+      ::operator delete(p, size);
+      return;
+    }
+    free_lists_[c] = new (p) free_frame{free_lists_[c]};
+  }
+};
+
+} // namespace details
+
+/**
+ * A source of bytes usable by async_parse.
+ *
+ * available() returns the bytes received and not consumed yet, consume(n) discards the first n of them, closed()
+ * tells whether more bytes may arrive and wait() returns an awaitable completing when new bytes are available or
+ * the source is closed. A suspended parse can be destroyed (e.g. when a connection is dropped): the awaitable must
+ * then stop referring to the waiting coroutine when it is destroyed.
+ *
+ * Consuming bytes must not move the available ones: the value returned by async_parse may refer to the parsed bytes
+ * (e.g. n_bytes), which must stay valid at least until the source receives more bytes.
+ */
+template <typename S>
+concept async_source = requires(S& s, std::size_t n) {
+  { s.available() } -> std::convertible_to<parse_input_t>;
+  s.consume(n);
+  { s.closed() } -> std::convertible_to<bool>;
+  s.wait();
+};
+
+/**
+ * The result of an asynchronous parse: a coroutine eventually producing an optional<a>.
+ *
+ * The coroutine starts eagerly and runs until it needs more input. The result can be awaited from another coroutine
+ * or, once done() is true, read with result(). Frames are allocated from a per thread pool.
+ *
+ * @tparam T The parsed type.
+ */
+template <typename T>
+class parse_task
+{
+public:
+  struct promise_type
+  {
+    std::optional<T> result;
+    std::coroutine_handle<> continuation;
+
+    static void* operator new(std::size_t size) { return details::frame_pool::local().allocate(size); }
+    static void operator delete(void* p, std::size_t size) { details::frame_pool::local().deallocate(p, size); }
+
+    parse_task get_return_object() { return parse_task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+
+    auto final_suspend() noexcept
+    {
+      struct resume_continuation
+      {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+        {
+          if (auto continuation = h.promise().continuation)
+          {
+            return continuation;
+          }
+          return std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+      };
+      return resume_continuation{};
+    }
+
+    void return_value(std::optional<T> value) { result = std::move(value); }
+    void unhandled_exception() { throw; }
+  };
+
+  parse_task(parse_task&& other) noexcept
+      : handle_{std::exchange(other.handle_, {})}
+  {}
+  parse_task& operator=(parse_task&& other) noexcept
+  {
+    std::swap(handle_, other.handle_);
+    return *this;
+  }
+  ~parse_task()
+  {
+    if (handle_)
+    {
+      handle_.destroy();
+    }
+  }
+
+  /**
+   * @return True once the parse completed, successfully or not.
+   */
+  [[nodiscard]] bool done() const { return handle_.done(); }
+
+  /**
+   * @return The parsed value or nullopt if the parse failed. The task must be done.
+   */
+  [[nodiscard]] std::optional<T>& result() { return handle_.promise().result; }
+
+  auto operator co_await() &&
+  {
+    struct awaiter
+    {
+      std::coroutine_handle<promise_type> handle;
+
+      bool await_ready() { return handle.done(); }
+      void await_suspend(std::coroutine_handle<> continuation) { handle.promise().continuation = continuation; }
+      std::optional<T> await_resume() { return std::move(handle.promise().result); }
+    };
+    return awaiter{handle_};
+  }
+
+private:
+  explicit parse_task(std::coroutine_handle<promise_type> handle)
+      : handle_{handle}
+  {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Parse one value from an asynchronous source.
+ *
+ * p is run on the available bytes and, when it fails, the coroutine suspends until the source delivers more bytes
+ * and tries again. The parse fails when p fails on a closed source or on at least max_size bytes. On success, the
+ * parsed bytes are consumed from the source. A parsed value referring to the input (e.g. a span returned by n_bytes)
+ * refers to the buffer of the source and is only valid until the source receives more bytes.
+ *
+ * A parser cannot tell a truncated message from a malformed one, so max_size is what makes a malformed stream fail
+ * instead of waiting (and buffering) forever. It should be the largest size a valid message can have.
+ *
+ * @tparam P A parser of a: i -> optional<(a, i)>.
+ * @param source The source of bytes, which must outlive the task.
+ * @param p The parser, copied into the coroutine frame.
+ * @param max_size The size from which a failure of p is considered final, at least the minimum size of p.
+ * @return A task producing optional<a>.
+ */
+template <async_source S, typename P>
+parse_task<details::parsed_t<P>> async_parse(S& source, P p, std::size_t max_size)
+{
+  const auto min_size = details::min_size(p);
+  while (true)
+  {
+    const parse_input_t input = source.available();
+    if (input.size() >= min_size)
+    {
+      if (auto r = p(input))
+      {
+        source.consume(input.size() - r->second.size());
+        co_return std::move(r->first);
+      }
+    }
+    if (source.closed() || input.size() >= max_size)
+    {
+      co_return std::nullopt;
+    }
+    co_await source.wait();
+  }
+}
+
+/**
+ * A local, single threaded async_source: bytes pushed by the owner (e.g. a reactor callback on a readable socket)
+ * resume the coroutine waiting on it.
+ *
+ * The available bytes, and the values parsed from them, stay valid until the next push.
+ */
+class byte_channel
+{
+  std::vector<std::byte> buffer_;
+  std::size_t consumed_ = 0;
+  bool closed_ = false;
+  std::coroutine_handle<> waiter_;
+
+  void resume_waiter()
+  {
+    if (auto waiter = std::exchange(waiter_, {}))
+    {
+      waiter.resume();
+    }
+  }
+
+public:
+  /**
+   * Append bytes to the channel and resume the coroutine waiting for them, if any.
+   * @param bytes The received bytes.
+   */
+  void push(parse_input_t bytes)
+  {
+    // Compact lazily so that consuming stays cheap, and only here so that consumed bytes stay valid until now.
+    if (consumed_ * 2 >= buffer_.size())
+    {
+      buffer_.erase(buffer_.begin(), std::next(buffer_.begin(), static_cast<std::ptrdiff_t>(consumed_)));
+      consumed_ = 0;
+    }
+    buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+    resume_waiter();
+  }
+
+  /**
+   * Signal that no more bytes will be pushed and resume the waiting coroutine, if any.
+   */
+  void close()
+  {
+    closed_ = true;
+    resume_waiter();
+  }
+
+  [[nodiscard]] parse_input_t available() const { return parse_input_t{buffer_}.subspan(consumed_); }
+  [[nodiscard]] bool closed() const { return closed_; }
+
+  void consume(std::size_t n) { consumed_ += n; }
+
+  auto wait()
+  {
+    // Lives in the frame of the waiting coroutine, it deregisters the coroutine if the frame is destroyed while
+    // suspended so that the channel never resumes a freed frame.
+    class awaiter
+    {
+      byte_channel& channel_;
+      std::coroutine_handle<> waiting_;
+
+    public:
+      explicit awaiter(byte_channel& channel)
+          : channel_{channel}
+      {}
+      awaiter(const awaiter&) = delete;
+      awaiter& operator=(const awaiter&) = delete;
+      ~awaiter()
+      {
+        if (waiting_ && channel_.waiter_ == waiting_)
+        {
+          channel_.waiter_ = {};
+        }
+      }
+
+      [[nodiscard]] bool await_ready() const { return channel_.closed_; }
+      void await_suspend(std::coroutine_handle<> h)
+      {
+        waiting_ = h;
+        channel_.waiter_ = h;
+      }
+      void await_resume() {}
+    };
+    return awaiter{*this};
+  }
+};
+
+} // namespace parse_it
+
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+#ifndef PARSE_IT_BATCH_H
+#define PARSE_IT_BATCH_H
+
+/**
+ * Parsing of batches of independent inputs (e.g. the datagrams received by one poll).
+ *
+ * @see parser.h for more information about parsers.
+ */
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "parser_details.h"
+#include "parser_types.h"
+
+namespace parse_it {
+
+namespace details {
+
+// Hint the CPU to load the cache line of an address ahead of its use.
+inline void prefetch(const std::byte* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0, 3);
+#else
+  static_cast<void>(address);
+#endif
+}
+
+// Prefetch the first cache lines of an input.
+inline void prefetch_input(parse_input_t input)
+{
+  constexpr std::size_t cache_line = 64;
+  constexpr std::size_t max_prefetched = 4 * cache_line;
+  const auto size = std::min(input.size(), max_prefetched);
+  for (std::size_t offset = 0; offset < size; offset += cache_line)
+  {
+    prefetch(input.data() + offset);
+  }
+}
+
+} // namespace details
+
+/**
+ * Parse a batch of independent inputs, each one holding one message.
+ *
+ * Inputs are parsed by groups of 4 while the inputs of the next four groups are prefetched. The loads of the messages
+ * of a group are thus already in flight when they are parsed and, the parses being independent, the CPU overlaps
+ * them instead of stalling on a cache miss per message. Inputs smaller than the minimum size of p are rejected
+ * without being touched.
+ *
+ * At most MAX_BATCH inputs are parsed by one call and the inputs left are returned, so that larger batches are
+ * parsed by calling parse_batch again on them (and on the matching part of out).
+ *
+ * @tparam MAX_BATCH The maximum number of inputs parsed by one call, the size of the returned bitmap.
+ * @tparam P A parser of a: i -> optional<(a, i)>.
+ * @param inputs The inputs.
+ * @param out The parsed values, out[i] is assigned the value parsed from inputs[i] when its parse succeeds. Inputs
+ * after the end of out are not parsed.
+ * @return A bitmap whose bit i is set when the parse of inputs[i] succeeded, and the inputs that were not parsed.
+ */
+template <std::size_t MAX_BATCH = 64, typename P, typename T, std::size_t EXTENT>
+std::pair<std::bitset<MAX_BATCH>, std::span<const parse_input_t>>
+parse_batch(const P& p, std::span<const parse_input_t> inputs, std::span<T, EXTENT> out)
+{
+  constexpr std::size_t group_size = 4;
+  constexpr std::size_t prefetch_distance = 4 * group_size;
+
+  auto success = std::bitset<MAX_BATCH>{};
+  const auto count = std::min({inputs.size(), out.size(), MAX_BATCH});
+  const auto min_size = details::min_size(p);
+
+  for (std::size_t i = 0; i < std::min(count, prefetch_distance); ++i)
+  {
+    details::prefetch_input(inputs[i]);
+  }
+  for (std::size_t first = 0; first < count; first += group_size)
+  {
+    const auto last = std::min(first + group_size, count);
+    for (auto i = first + prefetch_distance; i < std::min(last + prefetch_distance, count); ++i)
+    {
+      details::prefetch_input(inputs[i]);
+    }
+    for (auto i = first; i < last; ++i)
+    {
+      const auto input = inputs[i];
+      if (input.size() < min_size)
+      {
+        continue;
+      }
+      auto c = details::cursor{input.data(), input.data() + input.size()};
+      if (auto r = details::step(p, c))
+      {
+        out[i] = std::move(*r);
+        success.set(i);
+      }
+    }
+  }
+  return std::pair(success, inputs.subspan(count));
+}
+
+} // namespace parse_it
+
+#endif
@@ -3,51 +3,101 @@
 #define PARSE_IT_PARSER_H
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <concepts>
 #include <iterator>
+#include <limits>
 
 #include "parser_details.h"
 #include "parser_types.h"
+#include "segmented_input.h"
 #include "utils/arithmetic.h"
+#include "utils/checksum.h"
+#include "utils/static_vector.h"
 
 namespace parse_it {
 
 /**
  * Create a parser of one byte of value b.
+ *
+ * The parser accepts both contiguous (parse_input_t) and segmented (segmented_input) inputs.
+ *
  * @param b The byte to parse.
  * @return A parser of type: i -> optional<(b, i)>
  */
 constexpr inline auto one_byte(std::byte b)
 {
-  return [b](parse_input_t input) -> parse_result_t<std::byte> {
-    if (input.empty())
+  auto step = details::stateful_step{
+    b, [](std::byte expected, details::cursor& c) -> std::optional<std::byte> {
+      if (c.empty() || *c.it != expected)
+      {
+        return std::nullopt;
+      }
+      ++c.it;
+      return expected;
+    }};
+  auto step_segmented = [](std::byte expected, segmented_input input) -> segmented_result_t<std::byte> {
+    if (input.empty() || input.front_segment()[0] != expected)
     {
       return std::nullopt;
     }
-    if (input[0] == b)
-      return std::pair(b, input.subspan(1));
-    return std::nullopt;
+    return std::pair(expected, input.subspan(1));
   };
+  auto encode = details::encoder{
+    [](const auto& self, std::byte value) -> std::optional<std::size_t> {
+      if (value != self.state)
+      {
+        return std::nullopt;
+      }
+      return 1;
+    },
+    [](const auto&, std::byte value, std::byte* out) {
+      *out = value;
+      return out + 1;
+    }};
+  return details::segmented_parser{details::cursor_parser{std::move(step), 1, std::move(encode)}, step_segmented};
 }
 
 /**
  * Create a parser of one byte of any value.
+ *
+ * The parser accepts both contiguous (parse_input_t) and segmented (segmented_input) inputs.
+ *
  * @return A parser of type: i -> optional<(b, i)>
  */
 constexpr inline auto any_byte()
 {
-  return [](parse_input_t input) -> parse_result_t<std::byte> {
+  auto step = [](details::cursor& c) -> std::optional<std::byte> {
+    if (c.empty())
+    {
+      return std::nullopt;
+    }
+    return *c.it++;
+  };
+  auto step_segmented = [](segmented_input input) -> segmented_result_t<std::byte> {
     if (input.empty())
     {
       return std::nullopt;
     }
-    return std::pair(input[0], input.subspan(1));
+    return std::pair(input.front_segment()[0], input.subspan(1));
   };
+  auto encode = details::encoder{
+    [](const auto&, std::byte) -> std::optional<std::size_t> { return 1; },
+    [](const auto&, std::byte b, std::byte* out) {
+      *out = b;
+      return out + 1;
+    }};
+  return details::overloaded{
+    details::cursor_parser{std::move(step), 1, std::move(encode)}, std::move(step_segmented)};
 }
 
 /**
  * Create a parser for a sequence of bytes.
+ *
+ * The parser accepts both contiguous (parse_input_t) and segmented (segmented_input) inputs. On a segmented input
+ * the sequence is compared segment by segment, without stitching.
+ *
  * @param seq The sequence of byte to parse.
  * @return A parser of type: i -> optional<(seq, i)>
  */
@@ -55,83 +105,158 @@ template <typename SEQ>
 constexpr inline auto byte_seq(SEQ&& seq)
 {
   using sequence_type = std::remove_cv_t<std::remove_reference_t<SEQ>>;
-  return [seq = std::forward<SEQ>(seq)](parse_input_t input) -> parse_result_t<sequence_type> {
-    if (seq.size() > input.size())
+  const auto size = seq.size();
+  auto step = details::stateful_step{
+    std::forward<SEQ>(seq), [](const sequence_type& expected, details::cursor& c) -> std::optional<sequence_type> {
+      if (expected.size() > c.size() || !std::equal(expected.begin(), expected.end(), c.it))
+      {
+        return std::nullopt;
+      }
+      c.it += expected.size();
+      return expected;
+    }};
+  auto encode = details::encoder{
+    [](const auto& self, const auto& value) -> std::optional<std::size_t> {
+      const auto& expected = self.state;
+      if (!std::equal(value.begin(), value.end(), expected.begin(), expected.end()))
+      {
+        return std::nullopt;
+      }
+      return expected.size();
+    },
+    [](const auto& self, const auto&, std::byte* out) { return std::copy(self.state.begin(), self.state.end(), out); }};
+  auto step_segmented = [](const sequence_type& expected, segmented_input input) -> segmented_result_t<sequence_type> {
+    if (!input.starts_with(expected))
     {
       return std::nullopt;
     }
-    if (std::equal(seq.begin(), seq.end(), input.begin()))
-    {
-      return std::pair(seq, input.subspan(seq.size()));
-    }
-    return std::nullopt;
+    return std::pair(expected, input.subspan(expected.size()));
   };
+  return details::segmented_parser{details::cursor_parser{std::move(step), size, std::move(encode)}, step_segmented};
 }
 
 /**
  * Create a parser skipping n bytes.
+ *
+ * The parser accepts both contiguous (parse_input_t) and segmented (segmented_input) inputs.
+ *
  * @param n The number of bytes to skip.
  * @return A parser of type: i -> optional<(unit, i)>
  */
 constexpr inline auto skip(size_t n)
 {
-  return [n](parse_input_t input) -> parse_result_t<unit> {
-    if (input.size() >= n)
+  auto step = details::stateful_step{
+    n, [](std::size_t count, details::cursor& c) -> std::optional<unit> {
+      if (c.size() < count)
+      {
+        return std::nullopt;
+      }
+      c.it += count;
+      return unit{};
+    }};
+  auto step_segmented = [](std::size_t count, segmented_input input) -> segmented_result_t<unit> {
+    if (input.size() >= count)
     {
-      return std::pair(unit{}, input.subspan(n));
+      return std::pair(unit{}, input.subspan(count));
     }
     return std::nullopt;
   };
+  auto encode = details::encoder{
+    [](const auto& self, unit) -> std::optional<std::size_t> { return self.state; },
+    [](const auto& self, unit, std::byte* out) { return std::fill_n(out, self.state, std::byte{0}); }};
+  return details::segmented_parser{details::cursor_parser{std::move(step), n, std::move(encode)}, step_segmented};
 }
 
 /**
  * Create a parser of n bytes.
+ *
+ * The parser accepts both contiguous (parse_input_t) and segmented (segmented_input) inputs. On a segmented input
+ * the parsed bytes are returned as a segmented_input view so that no copy is made.
+ *
  * @param n The number of bytes to parse.
  * @return A parser of type: i -> optional<(span, i)>
  */
 constexpr inline auto n_bytes(size_t n)
 {
-  return [n](parse_input_t input) -> parse_result_t<std::span<const std::byte>> {
-    if (input.size() < n)
+  auto step = details::stateful_step{
+    n, [](std::size_t count, details::cursor& c) -> std::optional<std::span<const std::byte>> {
+      if (c.size() < count)
+      {
+        return std::nullopt;
+      }
+      const auto bytes = std::span<const std::byte>{c.it, count};
+      c.it += count;
+      return bytes;
+    }};
+  auto step_segmented = [](std::size_t count, segmented_input input) -> segmented_result_t<segmented_input> {
+    if (input.size() < count)
     {
       return std::nullopt;
     }
-    return std::pair(input.subspan(0, n), input.subspan(n));
+    return std::pair(input.first(count), input.subspan(count));
   };
+  auto encode = details::encoder{
+    [](const auto& self, std::span<const std::byte> bytes) -> std::optional<std::size_t> {
+      if (bytes.size() != self.state)
+      {
+        return std::nullopt;
+      }
+      return bytes.size();
+    },
+    [](const auto&, std::span<const std::byte> bytes, std::byte* out) {
+      return std::copy(bytes.begin(), bytes.end(), out);
+    }};
+  return details::segmented_parser{details::cursor_parser{std::move(step), n, std::move(encode)}, step_segmented};
 }
 
 /**
  * Create a parser of an arithmetic values of type T using the given endianness.
+ *
+ * The parser accepts both contiguous (parse_input_t) and segmented (segmented_input) inputs. On a segmented input,
+ * values fitting in the current segment are read in place and only values crossing a segment boundary are stitched
+ * in a small buffer on the stack.
+ *
  * @return A parser of type: i -> optional<(t, i)>
  */
 template <arithmetic T, std::endian FROM_ENDIAN = std::endian::big>
 constexpr inline auto arithmetic_parser()
 {
-  return [](parse_input_t input) -> parse_result_t<T> {
-    static_assert(
-      std::endian::native == std::endian::little || std::endian::native == std::endian::big,
-      "Only little en big endian platforms are supported.");
-    constexpr auto size = sizeof(T);
-    if (input.size() < size)
+  constexpr auto size = sizeof(T);
+  auto step = [](details::cursor& c) -> std::optional<T> {
+    if (c.size() < size)
     {
       return std::nullopt;
     }
-
-    T value = 0;
-    if constexpr (FROM_ENDIAN == std::endian::native)
+    const auto value = details::load_arithmetic<T, FROM_ENDIAN>(c.it);
+    c.it += size;
+    return value;
+  };
+  auto step_segmented = [](segmented_input input) -> segmented_result_t<T> {
+    if (input.size() < size)
     {
-      std::copy(input.begin(), std::next(input.begin(), size), reinterpret_cast<std::byte*>(&value));
+      return std::nullopt;
     }
-    else
+    const auto front = input.front_segment();
+    if (front.size() >= size)
     {
-      std::reverse_copy(input.begin(), std::next(input.begin(), size), reinterpret_cast<std::byte*>(&value));
+      return std::pair(details::load_arithmetic<T, FROM_ENDIAN>(front.data()), input.subspan(size));
     }
-    return std::pair(value, input.subspan(size));
+    std::array<std::byte, size> stitched{};
+    input.copy(size, stitched.begin());
+    return std::pair(details::load_arithmetic<T, FROM_ENDIAN>(stitched.data()), input.subspan(size));
   };
+  auto encode = details::encoder{
+    [](const auto&, T) -> std::optional<std::size_t> { return size; },
+    [](const auto&, T value, std::byte* out) { return details::store_arithmetic<T, FROM_ENDIAN>(value, out); }};
+  return details::overloaded{
+    details::cursor_parser{std::move(step), size, std::move(encode)}, std::move(step_segmented)};
 }
 
 /**
  * Apply a function to the result of a parser.
+ *
+ * The parser accepts segmented inputs when p parses them into the same type as contiguous inputs.
+ *
  * @tparam F A function from a to b: a -> b
  * @tparam P A parser of a: i -> optional<(a, i)>
  * @return A parser of type: i -> optional<(b, i)>
@@ -139,15 +264,88 @@ constexpr inline auto arithmetic_parser()
 template <typename F, typename P>
 constexpr inline auto fmap(F&& f, P&& p)
 {
-  using R = parse_result_t<decltype(f(details::parsed_t<P>{}))>;
-  return [f = std::forward<F>(f), p = std::forward<P>(p)](parse_input_t data) -> R {
-    auto r = p(data);
-    if (!r)
-    {
-      return std::nullopt;
-    }
-    return std::make_pair(f(r->first), r->second);
+  using R = decltype(f(details::parsed_t<P>{}));
+  struct state
+  {
+    [[no_unique_address]] std::decay_t<F> f;
+    std::decay_t<P> p;
   };
+  const auto size = details::min_size(p);
+  auto parser = details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<F>(f), std::forward<P>(p)},
+      [](const state& s, details::cursor& c) -> std::optional<R> {
+        auto r = details::step(s.p, c);
+        if (!r)
+        {
+          return std::nullopt;
+        }
+        return s.f(std::move(*r));
+      }},
+    size};
+  if constexpr (details::segmented_parser_of<std::decay_t<P>, details::parsed_t<P>>)
+  {
+    return details::segmented_parser{std::move(parser), [](const state& s, segmented_input input) {
+                                       return details::fmap_segmented<R>(s.f, s.p, input);
+                                     }};
+  }
+  else
+  {
+    return parser;
+  }
+}
+
+/**
+ * Apply a function to the result of a parser, with its inverse to encode values.
+ *
+ * The parser behaves like fmap(f, p), its encoder applies f_inverse to the values before encoding them with p.
+ * Likewise, it accepts segmented inputs when p parses them into the same type as contiguous inputs.
+ *
+ * @tparam F A function from a to b: a -> b
+ * @tparam G The inverse of F: b -> a
+ * @tparam P A parser of a: i -> optional<(a, i)>
+ * @return A parser of type: i -> optional<(b, i)>
+ */
+template <typename F, typename G, typename P>
+constexpr inline auto fmap(F&& f, G&& f_inverse, P&& p)
+{
+  using R = decltype(f(details::parsed_t<P>{}));
+  struct state
+  {
+    [[no_unique_address]] std::decay_t<F> f;
+    [[no_unique_address]] std::decay_t<G> f_inverse;
+    std::decay_t<P> p;
+  };
+  const auto size = details::min_size(p);
+  auto encode = details::encoder{
+    [](const auto& self, const auto& value) {
+      return details::encoded_size_with(self.state.p, self.state.f_inverse(value));
+    },
+    [](const auto& self, const auto& value, std::byte* out) {
+      return details::encode_with(self.state.p, self.state.f_inverse(value), out);
+    }};
+  auto parser = details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<F>(f), std::forward<G>(f_inverse), std::forward<P>(p)},
+      [](const state& s, details::cursor& c) -> std::optional<R> {
+        auto r = details::step(s.p, c);
+        if (!r)
+        {
+          return std::nullopt;
+        }
+        return s.f(std::move(*r));
+      }},
+    size, std::move(encode)};
+  if constexpr (details::segmented_parser_of<std::decay_t<P>, details::parsed_t<P>>)
+  {
+    return details::segmented_parser{std::move(parser), [](const state& s, segmented_input input) {
+                                       return details::fmap_segmented<R>(s.f, s.p, input);
+                                     }};
+  }
+  else
+  {
+    return parser;
+  }
 }
 
 /**
@@ -156,6 +354,12 @@ constexpr inline auto fmap(F&& f, P&& p)
  * If one of the parser fails, the combined parser fails. If every parser succeeds, f is called with all the results
  * to provide the final result.
  *
+ * The encoder of the combined parser takes the tuple of the values of every parser. To encode values of type a, use
+ * fmap with an inverse function on a combined parser returning that tuple.
+ *
+ * The combined parser accepts segmented inputs when every parser parses them into the same type as contiguous inputs
+ * (e.g. one_byte, byte_seq, arithmetic_parser, or fmap and combine of those).
+ *
  * @tparam F A function of type: 't1 -> t2 -> ... -> tN -> a' where t1 to tN are the results of parsers P1 to PN.
  * @tparam Ps The parsers to combine.
  * @return A parser of type: i -> optional<(a, i)>
@@ -163,16 +367,37 @@ constexpr inline auto fmap(F&& f, P&& p)
 template <typename F, typename... Ps>
 constexpr inline auto combine(F&& f, Ps&&... ps)
 {
-  auto combiner = details::make_combiner(std::forward<Ps>(ps)...);
+  const auto size = (details::min_size(ps) + ...);
   using T = std::invoke_result_t<F, details::parsed_t<Ps>...>;
-  return [f = std::forward<F>(f), combiner = std::move(combiner)](parse_input_t data) -> parse_result_t<T> {
-    auto result = combiner(data);
-    if (!result)
-    {
-      return std::nullopt;
-    }
-    return std::make_pair(std::apply(f, result->first), result->second);
+  struct state
+  {
+    [[no_unique_address]] std::decay_t<F> f;
+    details::combiner<Ps...> parsers;
   };
+  auto parser = details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<F>(f), details::make_combiner(std::forward<Ps>(ps)...)},
+      [](const state& s, details::cursor& c) -> std::optional<T> {
+        auto result = s.parsers(c);
+        if (!result)
+        {
+          return std::nullopt;
+        }
+        return std::apply(s.f, std::move(*result));
+      }},
+    size, details::tuple_encoder<sizeof...(Ps)>()};
+  if constexpr (std::is_invocable_v<const details::combiner<Ps...>&, segmented_input>)
+  {
+    return details::segmented_parser{std::move(parser), [](const state& s, segmented_input input) {
+                                       return details::fmap_segmented<T>(
+                                         [&s](auto values) { return std::apply(s.f, std::move(values)); }, s.parsers,
+                                         input);
+                                     }};
+  }
+  else
+  {
+    return parser;
+  }
 }
 
 /**
@@ -190,16 +415,21 @@ constexpr inline auto operator||(P1&& p1, P2&& p2)
     std::is_same<details::parsed_t<P1>, details::parsed_t<P2>>::value,
     "Both parser used in a || should parse the same type.");
   using T = details::parsed_t<P1>;
-  return [p1 = std::forward<P1>(p1), p2 = std::forward<P2>(p2)](parse_input_t data) -> parse_result_t<T> {
-    if (data.empty())
-    {
-      return std::nullopt;
-    }
-    auto r1 = p1(data);
-    if (r1)
-      return r1;
-    return p2(data);
-  };
+  const auto size = std::min(details::min_size(p1), details::min_size(p2));
+  return details::cursor_parser{
+    [p1 = std::forward<P1>(p1), p2 = std::forward<P2>(p2)](details::cursor& c) -> std::optional<T> {
+      if (c.empty())
+      {
+        return std::nullopt;
+      }
+      const auto start = c.it;
+      auto r1 = details::step(p1, c);
+      if (r1)
+        return r1;
+      c.it = start;
+      return details::step(p2, c);
+    },
+    size};
 }
 
 /**
@@ -210,22 +440,361 @@ constexpr inline auto operator||(P1&& p1, P2&& p2)
  * @return A parser of t: i -> optional<(t, i)>.
  * If the parser fails at instantly returns a parser of the initial value: i ->
  * optional<(init, i)>.
+ * The encoder of the parser takes a range of values of type a.
  *        */
 template <typename F, typename T, typename P>
-inline auto many(P&& p, T i, F&& f)
-{
-  return [f = std::forward<F>(f), i = std::move(i), p = std::forward<P>(p)](parse_input_t data) -> parse_result_t<T> {
-    T value = std::move(i);
-    auto r = p(data);
-    if (!r)
-      return std::make_pair(value, data);
-    while (r)
-    {
-      value = f(std::move(value), r->first);
-      r = p(r->second);
-    }
-    return std::make_pair(value, r->second);
+constexpr inline auto many(P&& p, T i, F&& f)
+{
+  struct state
+  {
+    [[no_unique_address]] std::decay_t<F> f;
+    T i;
+    std::decay_t<P> p;
+  };
+  return details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<F>(f), std::move(i), std::forward<P>(p)},
+      [](const state& s, details::cursor& c) -> std::optional<T> {
+        T value = s.i;
+        auto parsed = c.it;
+        while (auto r = details::step(s.p, c))
+        {
+          value = s.f(std::move(value), std::move(*r));
+          parsed = c.it;
+        }
+        // Give back the bytes consumed by the failing attempt.
+        c.it = parsed;
+        return value;
+      }},
+    0, details::range_encoder(
+      [](const state&) { return std::pair{std::size_t{0}, std::numeric_limits<std::size_t>::max()}; })};
+}
+
+/**
+ * Execute the same parser exactly N times.
+ *
+ * Inputs smaller than N times the minimum size of p are rejected before running p.
+ *
+ * @tparam N The number of repetitions.
+ * @tparam P A parser of a: i -> optional<(a, i)>, a must be default constructible.
+ * @return A parser of type: i -> optional<(array<a, N>, i)>
+ */
+template <std::size_t N, typename P>
+constexpr inline auto count(P&& p)
+{
+  using T = details::parsed_t<P>;
+  struct state
+  {
+    std::decay_t<P> p;
+    std::size_t size;
+  };
+  const auto size = N * details::min_size(p);
+  return details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<P>(p), size},
+      [](const state& s, details::cursor& c) -> std::optional<std::array<T, N>> {
+        if (c.size() < s.size)
+        {
+          return std::nullopt;
+        }
+        std::array<T, N> values{};
+        for (auto& value : values)
+        {
+          auto r = details::step(s.p, c);
+          if (!r)
+          {
+            return std::nullopt;
+          }
+          value = std::move(*r);
+        }
+        return values;
+      }},
+    size, details::range_encoder([](const state&) { return std::pair{N, N}; })};
+}
+
+/**
+ * Execute the same parser once per element of a caller provided buffer, storing the results in it.
+ *
+ * This allows parsing repeated groups whose count is only known at runtime (e.g. read from a header) without
+ * allocating: the parser is typically built with out.first(n). Inputs smaller than out.size() times the minimum
+ * size of p are rejected before running p.
+ *
+ * @tparam P A parser of a: i -> optional<(a, i)>.
+ * @param out The buffer receiving the parsed values, which must outlive the parser.
+ * @return A parser of type: i -> optional<(span<a>, i)>, returning out.
+ */
+template <typename T, std::size_t EXTENT, typename P>
+constexpr inline auto count(std::span<T, EXTENT> out, P&& p)
+{
+  static_assert(std::is_assignable_v<T&, details::parsed_t<P>>, "The parsed values must be assignable to out.");
+  struct state
+  {
+    std::span<T, EXTENT> out;
+    std::decay_t<P> p;
+    std::size_t size;
   };
+  const auto size = out.size() * details::min_size(p);
+  return details::cursor_parser{
+    details::stateful_step{
+      state{out, std::forward<P>(p), size},
+      [](const state& s, details::cursor& c) -> std::optional<std::span<T, EXTENT>> {
+        if (c.size() < s.size)
+        {
+          return std::nullopt;
+        }
+        for (auto& value : s.out)
+        {
+          auto r = details::step(s.p, c);
+          if (!r)
+          {
+            return std::nullopt;
+          }
+          value = std::move(*r);
+        }
+        return s.out;
+      }},
+    size, details::range_encoder([](const state& s) { return std::pair{s.out.size(), s.out.size()}; })};
+}
+
+/**
+ * Execute the same parser until it fails or has succeeded N times.
+ * @tparam N The maximum number of repetitions.
+ * @tparam P A parser of a: i -> optional<(a, i)>, a must be default constructible.
+ * @return A parser of type: i -> optional<(static_vector<a, N>, i)>
+ */
+template <std::size_t N, typename P>
+constexpr inline auto many_max(P&& p)
+{
+  using T = details::parsed_t<P>;
+  struct state
+  {
+    std::decay_t<P> p;
+  };
+  return details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<P>(p)},
+      [](const state& s, details::cursor& c) -> std::optional<static_vector<T, N>> {
+        static_vector<T, N> values;
+        auto parsed = c.it;
+        while (!values.full())
+        {
+          auto r = details::step(s.p, c);
+          if (!r)
+          {
+            break;
+          }
+          values.push_back(std::move(*r));
+          parsed = c.it;
+        }
+        c.it = parsed;
+        return values;
+      }},
+    0, details::range_encoder([](const state&) { return std::pair{std::size_t{0}, N}; })};
+}
+
+/**
+ * Execute a parser repeatedly, with a separator parser between each repetition, until one of them fails.
+ *
+ * A trailing separator which is not followed by p is not consumed.
+ *
+ * @tparam P A parser of a: i -> optional<(a, i)>.
+ * @tparam S A parser of the separator: i -> optional<(s, i)>.
+ * @tparam F An accumulating function: a -> t init -> t.
+ * @tparam T The initial accumulating value.
+ * @return A parser of t: i -> optional<(t, i)>.
+ */
+template <typename F, typename T, typename P, typename S>
+constexpr inline auto sep_by(P&& p, S&& sep, T i, F&& f)
+{
+  return details::cursor_parser{
+    [f = std::forward<F>(f), i = std::move(i), p = std::forward<P>(p), sep = std::forward<S>(sep)](
+      details::cursor& c) -> std::optional<T> {
+      T value = i;
+      auto parsed = c.it;
+      auto r = details::step(p, c);
+      while (r)
+      {
+        value = f(std::move(value), std::move(*r));
+        parsed = c.it;
+        r = details::step(sep, c) ? details::step(p, c) : std::nullopt;
+      }
+      c.it = parsed;
+      return value;
+    }};
+}
+
+/**
+ * Verify the checksum following the bytes consumed by a parser.
+ *
+ * The checksum is computed over the bytes consumed by p, right after p parsed them, and compared with the value
+ * stored after them. A checksum mismatch is reported as a parse failure.
+ *
+ * @tparam CHECKSUM The checksum algorithm (e.g. crc32, crc32c, adler32).
+ * @tparam FROM_ENDIAN The endianness of the stored checksum.
+ * @tparam P A parser of a: i -> optional<(a, i)>.
+ * @return A parser of a: i -> optional<(a, i)>, consuming the checksum as well.
+ */
+template <typename CHECKSUM, std::endian FROM_ENDIAN = std::endian::big, typename P>
+constexpr inline auto checksummed(P&& p)
+{
+  using T = details::parsed_t<P>;
+  using checksum_t = typename CHECKSUM::value_type;
+  struct state
+  {
+    std::decay_t<P> p;
+  };
+  const auto size = details::min_size(p) + sizeof(checksum_t);
+  auto encode = details::encoder{
+    [](const auto& self, const auto& value) {
+      return details::add_sizes(details::encoded_size_with(self.state.p, value), sizeof(checksum_t));
+    },
+    [](const auto& self, const auto& value, std::byte* out) {
+      const auto start = out;
+      out = details::encode_with(self.state.p, value, out);
+      const auto checksum = CHECKSUM::compute(parse_input_t{start, out});
+      return details::store_arithmetic<checksum_t, FROM_ENDIAN>(checksum, out);
+    }};
+  return details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<P>(p)},
+      [](const state& s, details::cursor& c) -> std::optional<T> {
+        const auto start = c.it;
+        auto r = details::step(s.p, c);
+        if (!r)
+        {
+          return std::nullopt;
+        }
+        const auto covered = parse_input_t{start, c.it};
+        const auto expected = details::step(arithmetic_parser<checksum_t, FROM_ENDIAN>(), c);
+        if (!expected || *expected != CHECKSUM::compute(covered))
+        {
+          return std::nullopt;
+        }
+        return r;
+      }},
+    size, std::move(encode)};
+}
+
+/**
+ * Find the next valid frame of a stream, skipping corrupted bytes.
+ *
+ * Candidate frames are located by searching the sync pattern, which must start every frame, with memchr on its
+ * first byte: the search runs at memory scan speed instead of retrying the frame parser at every offset. Each
+ * candidate is then validated by running the frame parser from the beginning of the pattern. To also validate
+ * frames with a checksum, use a checksummed frame parser.
+ *
+ * @tparam SEQ A contiguous sequence of bytes.
+ * @tparam P A parser of a: i -> optional<(a, i)>, parsing a frame including its sync pattern.
+ * @param sync_pattern The bytes starting every frame, must not be empty.
+ * @param frame_parser The frame parser.
+ * @return A parser of type: i -> optional<(resynced<a>, i)>, failing if no valid frame is found.
+ */
+template <typename SEQ, typename P>
+constexpr inline auto resync(SEQ&& sync_pattern, P&& frame_parser)
+{
+  using T = details::parsed_t<P>;
+  const auto size = details::min_size(frame_parser);
+  return details::cursor_parser{
+    [sync = std::forward<SEQ>(sync_pattern),
+     p = std::forward<P>(frame_parser)](details::cursor& c) -> std::optional<resynced<T>> {
+      const auto start = c.it;
+      const auto end = c.end;
+      auto position = start;
+      while (true)
+      {
+        const auto candidate = details::find_sequence(position, end, sync);
+        if (candidate == end)
+        {
+          return std::nullopt;
+        }
+        c.it = candidate;
+        if (auto r = details::step(p, c))
+        {
+          return resynced<T>{std::move(*r), parse_input_t{start, candidate}};
+        }
+        position = candidate + 1;
+      }
+    },
+    size};
+}
+
+/**
+ * Intern the bytes parsed by a parser (e.g. a symbol or identifier field) in a table.
+ *
+ * Repeated values are only copied on their first occurrence, afterwards the parser returns the symbol already in the
+ * table: a small integer id and bytes which stay valid as long as the table.
+ *
+ * @tparam P A parser of bytes: i -> optional<(b, i)> where b is convertible to parse_input_t.
+ * @tparam TABLE An intern table (e.g. intern_table or concurrent_intern_table from utils/intern_table.h).
+ * @param table The table, which must outlive the parser.
+ * @return A parser of type: i -> optional<(interned_symbol, i)>
+ */
+template <typename P, typename TABLE>
+constexpr inline auto interned(P&& p, TABLE& table)
+{
+  using symbol_type = decltype(table.intern(parse_input_t{}));
+  struct state
+  {
+    std::decay_t<P> p;
+    TABLE* table;
+  };
+  const auto size = details::min_size(p);
+  auto encode = details::encoder{
+    [](const auto& self, const symbol_type& symbol) { return details::encoded_size_with(self.state.p, symbol.bytes); },
+    [](const auto& self, const symbol_type& symbol, std::byte* out) {
+      return details::encode_with(self.state.p, symbol.bytes, out);
+    }};
+  return details::cursor_parser{
+    details::stateful_step{
+      state{std::forward<P>(p), &table},
+      [](const state& s, details::cursor& c) -> std::optional<symbol_type> {
+        auto r = details::step(s.p, c);
+        if (!r)
+        {
+          return std::nullopt;
+        }
+        return s.table->intern(parse_input_t{*r});
+      }},
+    size, std::move(encode)};
+}
+
+/**
+ * Get the number of bytes needed to encode a value in the format read by a parser.
+ * @tparam P A parser of a: i -> optional<(a, i)> providing an encoder.
+ * @param value The value to encode.
+ * @return The encoded size of value, nullopt if value cannot be encoded.
+ */
+template <typename P, typename V>
+constexpr std::optional<std::size_t> encoded_size(const P& p, const V& value)
+{
+  return details::encoded_size_with(p, value);
+}
+
+/**
+ * Encode a value in the format read by a parser.
+ *
+ * The size of the encoded value is computed first, so the output is bounds checked once and the bytes are then
+ * written without further checks. No allocation is made.
+ *
+ * Encoders are provided by one_byte, any_byte, byte_seq, skip (writing zeros), n_bytes, arithmetic_parser, combine
+ * (from a tuple of values), fmap with an inverse function, many, count, many_max (from a range of values),
+ * checksummed (computing the checksum) and interned.
+ *
+ * @tparam P A parser of a: i -> optional<(a, i)> providing an encoder.
+ * @param value The value to encode.
+ * @param out The buffer receiving the encoded bytes.
+ * @return The part of out following the encoded bytes, nullopt if value cannot be encoded or out is too small.
+ */
+template <typename P, typename V>
+constexpr std::optional<std::span<std::byte>> encode(const P& p, const V& value, std::span<std::byte> out)
+{
+  const auto size = details::encoded_size_with(p, value);
+  if (!size || *size > out.size())
+  {
+    return std::nullopt;
+  }
+  details::encode_with(p, value, out.data());
+  return out.subspan(*size);
 }
 
 } // namespace parse_it
@@ -8,9 +8,21 @@
  * @see parser.h for more information about parsers.
  */
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <ranges>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "parser_types.h"
+#include "segmented_input.h"
+#include "utils/arithmetic.h"
 
 namespace parse_it::details {
 
@@ -24,16 +36,431 @@ using parser_pair_t = typename parser_opt_pair_t<P>::value_type;
 template <typename P>
 using parsed_t = typename parser_pair_t<P>::first_type;
 
+/**
+ * Position of a parser in a contiguous input.
+ *
+ * Internally, parsers run on a cursor rather than on parse_input_t: a step reads bytes from [it, end), advances
+ * it past the consumed bytes and returns the parsed value, or nullopt on failure. This keeps the state threaded
+ * through combinators down to one pointer increment per step instead of building a new span and a
+ * optional<pair<T, span>> for every parser. On failure, the position of the cursor is unspecified and combinators
+ * needing to backtrack save it beforehand.
+ */
+struct cursor
+{
+  const std::byte* it;
+  const std::byte* end;
+
+  [[nodiscard]] constexpr std::size_t size() const { return static_cast<std::size_t>(end - it); }
+  [[nodiscard]] constexpr bool empty() const { return it == end; }
+};
+
+/**
+ * Cursor step keeping its state (e.g. its sub-parsers) in a member rather than in lambda captures, so that the
+ * encoder of its parser can use the same state instead of storing copies of it.
+ *
+ * @tparam State The state of the step.
+ * @tparam F A callable of type: state -> cursor& -> optional<a>.
+ */
+template <typename State, typename F>
+struct stateful_step
+{
+  State state;
+  [[no_unique_address]] F f;
+
+  constexpr auto operator()(cursor& c) const { return f(state, c); }
+};
+template <typename State, typename F>
+stateful_step(State, F) -> stateful_step<State, F>;
+
+/**
+ * Encoder writing values in the format read by a parser.
+ *
+ * Encoding is split in two so that a whole message is bounds checked once: size(v) returns the number of bytes
+ * needed to encode v (nullopt if v cannot be encoded, e.g. a span of the wrong size), then write(v, out) writes them
+ * without any check and returns a pointer past the written bytes.
+ *
+ * Both functions are given the step of the parser, encoders read the parameters and sub-parsers they need from it and
+ * should not hold copies of them.
+ *
+ * @tparam SizeF A callable of type: step -> v -> optional<size_t>.
+ * @tparam WriteF A callable of type: step -> v -> byte* -> byte*.
+ */
+template <typename SizeF, typename WriteF>
+struct encoder
+{
+  [[no_unique_address]] SizeF size_f;
+  [[no_unique_address]] WriteF write_f;
+
+  template <typename Step, typename V>
+  [[nodiscard]] constexpr std::optional<std::size_t> size(const Step& step, const V& value) const
+  {
+    return size_f(step, value);
+  }
+
+  template <typename Step, typename V>
+  constexpr std::byte* write(const Step& step, const V& value, std::byte* out) const
+  {
+    return write_f(step, value, out);
+  }
+};
+template <typename SizeF, typename WriteF>
+encoder(SizeF, WriteF) -> encoder<SizeF, WriteF>;
+
+// Encoder of parsers which cannot be reversed.
+struct no_encoder
+{};
+
+/**
+ * Parser defined by a cursor step, exposing the public i -> optional<(a, i)> interface on top of it.
+ *
+ * The parser also knows the minimum number of bytes it consumes on success, which lets combinators repeating it a
+ * known number of times reject inputs that are too small up front, and optionally an encoder producing the bytes
+ * it parses.
+ *
+ * @tparam Step A callable of type: cursor& -> optional<a>.
+ * @tparam Encoder The encoder of the parser, no_encoder if it has none.
+ */
+template <typename Step, typename Encoder = no_encoder>
+struct cursor_parser : Step
+{
+  using Step::operator();
+
+  constexpr explicit cursor_parser(Step step, std::size_t min_size = 0, Encoder encoder = {})
+      : Step{std::move(step)}
+      , min_size_{min_size}
+      , encoder_{std::move(encoder)}
+  {}
+
+  constexpr auto operator()(parse_input_t input) const
+    -> parse_result_t<typename std::invoke_result_t<const Step&, cursor&>::value_type>
+  {
+    auto c = cursor{input.data(), input.data() + input.size()};
+    auto r = static_cast<const Step&>(*this)(c);
+    if (!r)
+    {
+      return std::nullopt;
+    }
+    return std::pair(std::move(*r), input.subspan(input.size() - c.size()));
+  }
+
+  /**
+   * @return The minimum number of bytes consumed by the parser when it succeeds.
+   */
+  [[nodiscard]] constexpr std::size_t min_size() const { return min_size_; }
+
+  /**
+   * @return The number of bytes needed to encode value, nullopt if it cannot be encoded.
+   */
+  template <typename V>
+  [[nodiscard]] constexpr std::optional<std::size_t> encoded_size(const V& value) const
+    requires(!std::is_same_v<Encoder, no_encoder>)
+  {
+    return encoder_.size(static_cast<const Step&>(*this), value);
+  }
+
+  /**
+   * Encode value without bounds checking, out must have room for encoded_size(value) bytes.
+   * @return A pointer past the written bytes.
+   */
+  template <typename V>
+  constexpr std::byte* encode_to(const V& value, std::byte* out) const
+    requires(!std::is_same_v<Encoder, no_encoder>)
+  {
+    return encoder_.write(static_cast<const Step&>(*this), value, out);
+  }
+
+private:
+  std::size_t min_size_;
+  [[no_unique_address]] Encoder encoder_;
+};
+
+/**
+ * Get the minimum number of bytes consumed by a parser when it succeeds, 0 if the parser does not tell.
+ * @tparam P A parser of a: i -> optional<(a, i)>.
+ */
+template <typename P>
+constexpr std::size_t min_size(const P& p)
+{
+  if constexpr (requires { p.min_size(); })
+  {
+    return p.min_size();
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+// Get the encoded size of a value with the encoder of p.
+template <typename P, typename V>
+constexpr std::optional<std::size_t> encoded_size_with(const P& p, const V& value)
+{
+  static_assert(requires { p.encoded_size(value); }, "This parser has no encoder for this value.");
+  return p.encoded_size(value);
+}
+
+// Encode a value with the encoder of p, without bounds checking.
+template <typename P, typename V>
+constexpr std::byte* encode_with(const P& p, const V& value, std::byte* out)
+{
+  return p.encode_to(value, out);
+}
+
+// Add two encoded sizes, nullopt if any of them is nullopt.
+constexpr std::optional<std::size_t> add_sizes(std::optional<std::size_t> lhs, std::optional<std::size_t> rhs)
+{
+  if (!lhs || !rhs)
+  {
+    return std::nullopt;
+  }
+  return *lhs + *rhs;
+}
+
+/**
+ * Encoder of a range of values, each one encoded by the encoder of the repeated parser.
+ *
+ * The encoder is used with a stateful_step whose state holds the repeated parser in a member named p.
+ *
+ * @tparam Bounds A stateless callable of type: state -> (min_count, max_count), the number of values the range must
+ * contain to be encodable.
+ */
+template <typename Bounds>
+constexpr auto range_encoder(Bounds)
+{
+  return encoder{
+    [](const auto& self, const auto& values) -> std::optional<std::size_t> {
+      const auto count = static_cast<std::size_t>(std::ranges::distance(values));
+      const auto [min_count, max_count] = Bounds{}(self.state);
+      if (count < min_count || count > max_count)
+      {
+        return std::nullopt;
+      }
+      std::optional<std::size_t> size = 0;
+      for (const auto& value : values)
+      {
+        size = add_sizes(size, encoded_size_with(self.state.p, value));
+      }
+      return size;
+    },
+    [](const auto& self, const auto& values, std::byte* out) {
+      for (const auto& value : values)
+      {
+        out = encode_with(self.state.p, value, out);
+      }
+      return out;
+    }};
+}
+
+/**
+ * Encoder of a tuple of values, the I-th one encoded by the encoder of the I-th combined parser.
+ *
+ * The encoder is used with a stateful_step whose state holds the combiner of the parsers in a member named parsers.
+ *
+ * @tparam N The number of combined parsers.
+ */
+template <std::size_t N>
+constexpr auto tuple_encoder()
+{
+  return encoder{
+    [](const auto& self, const auto& values) {
+      return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        std::optional<std::size_t> size = 0;
+        ((size = add_sizes(
+            size, encoded_size_with(self.state.parsers.template parser<Is>(), std::get<Is>(values)))),
+         ...);
+        return size;
+      }(std::make_index_sequence<N>{});
+    },
+    [](const auto& self, const auto& values, std::byte* out) {
+      return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ((out = encode_with(self.state.parsers.template parser<Is>(), std::get<Is>(values), out)), ...);
+        return out;
+      }(std::make_index_sequence<N>{});
+    }};
+}
+
+/**
+ * Run one parser step on a cursor.
+ *
+ * Parsers built by this library are run directly on the cursor, any other parser (e.g. a user defined lambda of
+ * type: parse_input_t -> parse_result_t<a>) is run on the remaining input and the cursor is advanced accordingly.
+ *
+ * @tparam P A parser of a: i -> optional<(a, i)>.
+ * @return The parsed value or nullopt.
+ */
+template <typename P>
+constexpr std::optional<parsed_t<P>> step(const P& p, cursor& c)
+{
+  if constexpr (std::is_invocable_v<const P&, cursor&>)
+  {
+    return p(c);
+  }
+  else
+  {
+    auto r = p(parse_input_t{c.it, c.end});
+    if (!r)
+    {
+      return std::nullopt;
+    }
+    c.it = c.end - r->second.size();
+    return std::move(r->first);
+  }
+}
+
+/**
+ * Overload set built from multiple callables, used by parsers accepting several input types.
+ * @tparam Fs The callables.
+ */
+template <typename... Fs>
+struct overloaded : Fs...
+{
+  using Fs::operator()...;
+};
+template <typename... Fs>
+overloaded(Fs...) -> overloaded<Fs...>;
+
+// True when parser P parses segmented inputs into values of type T, the type it parses from contiguous inputs.
+template <typename P, typename T>
+concept segmented_parser_of = requires(const P& p, segmented_input input) {
+  { p(input) } -> std::same_as<segmented_result_t<T>>;
+};
+
+/**
+ * A parser of contiguous inputs also accepting segmented inputs.
+ *
+ * The segmented step reads the state of the stateful step of the parser, so that both kinds of inputs share one copy
+ * of that state.
+ *
+ * @tparam Parser A cursor_parser of a stateful_step.
+ * @tparam F A stateless callable of type: (state, segmented_input) -> segmented_result_t<a>.
+ */
+template <typename Parser, typename F>
+struct segmented_parser : Parser
+{
+  using Parser::operator();
+
+  constexpr segmented_parser(Parser parser, F)
+      : Parser{std::move(parser)}
+  {}
+
+  constexpr auto operator()(segmented_input input) const { return F{}(this->state, input); }
+};
+
+/**
+ * Apply a function to the value parsed from a segmented input.
+ * @tparam R The type returned by f.
+ * @return The result of f and the rest of the input, nullopt if p fails.
+ */
+template <typename R, typename F, typename P>
+constexpr segmented_result_t<R> fmap_segmented(const F& f, const P& p, segmented_input input)
+{
+  auto r = p(input);
+  if (!r)
+  {
+    return std::nullopt;
+  }
+  return std::pair(f(std::move(r->first)), r->second);
+}
+
+/**
+ * Find the first occurrence of a sequence of bytes.
+ *
+ * The search uses memchr (vectorized by the C library) on the first byte of the sequence and compares the remaining
+ * bytes at each hit.
+ *
+ * @param first The beginning of the searched bytes.
+ * @param last The end of the searched bytes.
+ * @param seq The sequence to find, must not be empty.
+ * @return A pointer to the first occurrence of seq, or last if there is none.
+ */
+template <typename SEQ>
+constexpr const std::byte* find_sequence(const std::byte* first, const std::byte* last, const SEQ& seq)
+{
+  const auto head = *seq.begin();
+  const auto tail_size = static_cast<std::ptrdiff_t>(seq.size()) - 1;
+  while (last - first > tail_size)
+  {
+    const auto search_end = last - tail_size;
+    if (std::is_constant_evaluated())
+    {
+      first = std::find(first, search_end, head);
+    }
+    else
+    {
+      const auto found = std::memchr(first, std::to_integer<int>(head), static_cast<std::size_t>(search_end - first));
+      first = found ? static_cast<const std::byte*>(found) : search_end;
+    }
+    if (first == search_end)
+    {
+      return last;
+    }
+    if (std::equal(std::next(seq.begin()), seq.end(), first + 1))
+    {
+      return first;
+    }
+    ++first;
+  }
+  return last;
+}
+
+/**
+ * Read an arithmetic value from the beginning of a byte buffer.
+ * @tparam T The arithmetic type to read.
+ * @tparam FROM_ENDIAN The endianness of the value in the buffer.
+ * @param bytes The buffer to read from, must contain at least sizeof(T) bytes.
+ * @return The value read.
+ */
+template <arithmetic T, std::endian FROM_ENDIAN>
+constexpr T load_arithmetic(const std::byte* bytes)
+{
+  static_assert(
+    std::endian::native == std::endian::little || std::endian::native == std::endian::big,
+    "Only little en big endian platforms are supported.");
+  constexpr auto size = sizeof(T);
+  std::array<std::byte, size> value{};
+  if constexpr (FROM_ENDIAN == std::endian::native)
+  {
+    std::copy(bytes, bytes + size, value.begin());
+  }
+  else
+  {
+    std::reverse_copy(bytes, bytes + size, value.begin());
+  }
+  return std::bit_cast<T>(value);
+}
+
+/**
+ * Write an arithmetic value at the beginning of a byte buffer.
+ * @tparam T The arithmetic type to write.
+ * @tparam TO_ENDIAN The endianness of the value in the buffer.
+ * @param value The value to write.
+ * @param out The buffer to write to, must have room for at least sizeof(T) bytes.
+ * @return A pointer past the written bytes.
+ */
+template <arithmetic T, std::endian TO_ENDIAN>
+constexpr std::byte* store_arithmetic(T value, std::byte* out)
+{
+  const auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+  if constexpr (TO_ENDIAN == std::endian::native)
+  {
+    return std::copy(bytes.begin(), bytes.end(), out);
+  }
+  else
+  {
+    return std::reverse_copy(bytes.begin(), bytes.end(), out);
+  }
+}
+
 /**
  * Utility class combining multiple parsers together.
  *
- * This class has a call operator executing every parser one after the other and combining their result
- * in a tuple. For parser P1 to PN, executing combiner<P1, ..., PN>(data) is equivalent to executing:
- *  auto r1 = P1(data);
- *  auto r2 = P2(r1.second);
+ * This class has a call operator executing every parser one after the other on a cursor and combining their result
+ * in a tuple. For parser P1 to PN, executing combiner<P1, ..., PN>(c) is equivalent to executing:
+ *  auto r1 = step(P1, c);
+ *  auto r2 = step(P2, c);
  *  ...
- *  auto rN = PN(rN-1.second);
- *  auto result = tuple(r1.first, r2.first, ..., rN.first);
+ *  auto rN = step(PN, c);
+ *  auto result = tuple(*r1, *r2, ..., *rN);
  * If any of the parsers fails, the combiner fails.
  *
  * @tparam Parsers The parsers to combine.
@@ -49,7 +476,7 @@ class combiner;
 template <typename Head, typename... Tail>
 class combiner<Head, Tail...>
 {
-  using Result = parse_result_t<std::tuple<parsed_t<Head>, parsed_t<Tail>...>>;
+  using Result = std::optional<std::tuple<parsed_t<Head>, parsed_t<Tail>...>>;
   std::decay_t<Head> p_;
   combiner<Tail...> tail_;
 
@@ -63,9 +490,25 @@ public:
   constexpr combiner(combiner&& other) = default;
   constexpr combiner(const combiner& other) = default;
 
-  auto operator()(parse_input_t data) const -> Result
+  constexpr auto operator()(cursor& c) const -> Result
+  {
+    auto r = step(p_, c);
+    if (!r)
+    {
+      return std::nullopt;
+    }
+    auto tail_result = tail_(c);
+    if (!tail_result)
+      return std::nullopt;
+    return std::tuple_cat(std::make_tuple(std::move(*r)), std::move(*tail_result));
+  }
+
+  constexpr auto operator()(segmented_input input) const -> segmented_result_t<typename Result::value_type>
+    requires(
+      segmented_parser_of<std::decay_t<Head>, parsed_t<Head>>
+      && std::is_invocable_v<const combiner<Tail...>&, segmented_input>)
   {
-    auto r = p_(data);
+    auto r = p_(input);
     if (!r)
     {
       return std::nullopt;
@@ -73,7 +516,24 @@ public:
     auto tail_result = tail_(r->second);
     if (!tail_result)
       return std::nullopt;
-    return std::make_pair(std::tuple_cat(std::make_tuple(r->first), tail_result->first), tail_result->second);
+    return std::pair(
+      std::tuple_cat(std::make_tuple(std::move(r->first)), std::move(tail_result->first)), tail_result->second);
+  }
+
+  /**
+   * @return The I-th combined parser.
+   */
+  template <std::size_t I>
+  [[nodiscard]] constexpr const auto& parser() const
+  {
+    if constexpr (I == 0)
+    {
+      return p_;
+    }
+    else
+    {
+      return tail_.template parser<I - 1>();
+    }
   }
 };
 
@@ -87,7 +547,7 @@ class combiner<Parser>
   std::decay_t<Parser> p_;
 
 public:
-  using Result = parse_result_t<std::tuple<parsed_t<Parser>>>;
+  using Result = std::optional<std::tuple<parsed_t<Parser>>>;
 
   template <typename P>
   constexpr combiner(P p)
@@ -97,12 +557,31 @@ public:
   constexpr combiner(combiner&& other) = default;
   constexpr combiner(const combiner& other) = default;
 
-  auto operator()(parse_input_t data) const -> Result
+  constexpr auto operator()(cursor& c) const -> Result
   {
-    auto r = p_(data);
+    auto r = step(p_, c);
     if (!r)
       return std::nullopt;
-    return std::make_pair(std::make_tuple(r->first), r->second);
+    return std::make_tuple(std::move(*r));
+  }
+
+  constexpr auto operator()(segmented_input input) const -> segmented_result_t<typename Result::value_type>
+    requires segmented_parser_of<std::decay_t<Parser>, parsed_t<Parser>>
+  {
+    auto r = p_(input);
+    if (!r)
+      return std::nullopt;
+    return std::pair(std::make_tuple(std::move(r->first)), r->second);
+  }
+
+  /**
+   * @return The combined parser.
+   */
+  template <std::size_t I>
+  [[nodiscard]] constexpr const auto& parser() const
+  {
+    static_assert(I == 0, "Parser index out of range.");
+    return p_;
   }
 };
 
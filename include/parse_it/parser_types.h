@@ -27,6 +27,18 @@ using parse_result_t = std::optional<std::pair<T, parse_input_t>>;
 struct unit
 {};
 
+/**
+ * A value parsed after skipping corrupted bytes.
+ */
+template <typename T>
+struct resynced
+{
+  // The parsed value.
+  T value;
+  // The bytes skipped before the value was found, empty if it was found right away.
+  parse_input_t skipped;
+};
+
 } // namespace parse_it
 
 #endif
@@ -0,0 +1,166 @@
+#pragma once
+#ifndef PARSE_IT_SEGMENTED_INPUT_H
+#define PARSE_IT_SEGMENTED_INPUT_H
+
+/**
+ * Non-contiguous parser input.
+ *
+ * @see parser.h for more information about parsers.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include "parser_types.h"
+
+namespace parse_it {
+
+/**
+ * A view over a sequence of byte segments (e.g. an iovec chain or the two halves of a ring buffer) that parsers
+ * can consume as if it were a single input without coalescing the segments first.
+ *
+ * The view does not own the segments nor the bytes they refer to. Like a span, advancing it (subspan) or
+ * truncating it (first) returns a new view.
+ *
+ * It is accepted by the byte and arithmetic primitives, and by fmap and combine when every parser they apply accepts
+ * it. The other combinators (many, count, ||, checksummed...) only accept contiguous inputs.
+ */
+class segmented_input
+{
+  std::span<const parse_input_t> segments_;
+  std::size_t offset_ = 0;
+  std::size_t size_ = 0;
+
+  constexpr segmented_input(std::span<const parse_input_t> segments, std::size_t offset, std::size_t size)
+      : segments_{segments}
+      , offset_{offset}
+      , size_{size}
+  {
+    skip_exhausted_segments();
+  }
+
+  // Make sure the current segment is not fully consumed so that front_segment() is never empty on a non empty input.
+  constexpr void skip_exhausted_segments()
+  {
+    while (!segments_.empty() && offset_ >= segments_.front().size())
+    {
+      offset_ -= segments_.front().size();
+      segments_ = segments_.subspan(1);
+    }
+  }
+
+public:
+  constexpr segmented_input() = default;
+
+  /**
+   * Create an input spanning every byte of the given segments, in order.
+   * @param segments The segments, which must outlive the input.
+   */
+  constexpr explicit segmented_input(std::span<const parse_input_t> segments)
+      : segments_{segments}
+  {
+    for (const auto& segment : segments_)
+    {
+      size_ += segment.size();
+    }
+    skip_exhausted_segments();
+  }
+
+  /**
+   * @return The number of bytes remaining in the input.
+   */
+  [[nodiscard]] constexpr std::size_t size() const { return size_; }
+
+  /**
+   * @return True if no byte remains in the input.
+   */
+  [[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+
+  /**
+   * @return The contiguous bytes remaining in the current segment. Empty only if the input is empty.
+   */
+  [[nodiscard]] constexpr parse_input_t front_segment() const
+  {
+    if (empty())
+    {
+      return {};
+    }
+    const auto front = segments_.front().subspan(offset_);
+    return front.first(std::min(front.size(), size_));
+  }
+
+  /**
+   * @param n The number of bytes to consume, must not be greater than size().
+   * @return The input remaining after the first n bytes.
+   */
+  [[nodiscard]] constexpr segmented_input subspan(std::size_t n) const
+  {
+    return segmented_input{segments_, offset_ + n, size_ - n};
+  }
+
+  /**
+   * @param n The number of bytes to keep, must not be greater than size().
+   * @return A view on the first n bytes of the input.
+   */
+  [[nodiscard]] constexpr segmented_input first(std::size_t n) const
+  {
+    return segmented_input{segments_, offset_, n};
+  }
+
+  /**
+   * Copy the first n bytes of the input, stitching segments together.
+   * @param n The number of bytes to copy, must not be greater than size().
+   * @param out The destination of the copy.
+   * @return An iterator past the last copied byte.
+   */
+  template <typename OutputIt>
+  constexpr OutputIt copy(std::size_t n, OutputIt out) const
+  {
+    auto remaining = first(n);
+    while (!remaining.empty())
+    {
+      const auto chunk = remaining.front_segment();
+      out = std::copy(chunk.begin(), chunk.end(), out);
+      remaining = remaining.subspan(chunk.size());
+    }
+    return out;
+  }
+
+  /**
+   * Compare the first bytes of the input with a contiguous sequence.
+   * @param seq The expected bytes.
+   * @return True if the input starts with seq.
+   */
+  template <typename SEQ>
+  [[nodiscard]] constexpr bool starts_with(const SEQ& seq) const
+  {
+    if (seq.size() > size_)
+    {
+      return false;
+    }
+    auto expected = seq.begin();
+    auto remaining = first(seq.size());
+    while (!remaining.empty())
+    {
+      const auto chunk = remaining.front_segment();
+      if (!std::equal(chunk.begin(), chunk.end(), expected))
+      {
+        return false;
+      }
+      expected = std::next(expected, static_cast<std::ptrdiff_t>(chunk.size()));
+      remaining = remaining.subspan(chunk.size());
+    }
+    return true;
+  }
+};
+
+/**
+ * Result type of parsers applied to a segmented input.
+ */
+template <typename T>
+using segmented_result_t = std::optional<std::pair<T, segmented_input>>;
+
+} // namespace parse_it
+
+#endif
@@ -0,0 +1,334 @@
+#pragma once
+#ifndef PARSE_IT_SPSC_RING_H
+#define PARSE_IT_SPSC_RING_H
+
+/**
+ * Lock-free single producer / single consumer byte ring feeding parsers.
+ *
+ * @see parser.h for more information about parsers.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "parser_types.h"
+
+namespace parse_it {
+
+/**
+ * How a thread waits for the other side of a ring.
+ *
+ * busy_poll spins on the shared counters, blocking sleeps using std::atomic::wait (a futex on Linux).
+ */
+enum class wait_policy
+{
+  busy_poll,
+  blocking
+};
+
+/**
+ * Snapshot of the counters of a ring.
+ */
+struct ring_stats
+{
+  // Bytes made visible to the consumer.
+  std::uint64_t bytes_published = 0;
+  // Number of publications (batches) made by the producer.
+  std::uint64_t publications = 0;
+  // Number of writes which could not fit entirely in the ring (backpressure).
+  std::uint64_t producer_stalls = 0;
+  // Records successfully parsed and handed to the consumer callback.
+  std::uint64_t records_parsed = 0;
+  // Number of times the consumer had to wait for more data.
+  std::uint64_t consumer_waits = 0;
+};
+
+/**
+ * A ring buffer of bytes shared by one producer thread (typically doing I/O) and one consumer thread running a
+ * parser over the readable bytes.
+ *
+ * The storage is mirrored: every byte is written twice, CAPACITY bytes apart, so that any readable region is
+ * contiguous and records never wrap around the end of the ring. Parsers can thus be applied directly to the
+ * readable bytes, without reassembly.
+ *
+ * Producer side: write() copies bytes into the ring and publish() makes every written byte visible to the
+ * consumer at once, which allows batched publication.
+ * Consumer side: drain() parses as many records as possible from the readable bytes and releases them, abort()
+ * stops the producer when the stream cannot be parsed.
+ *
+ * The ring holds 2 * CAPACITY bytes inline, it should usually be allocated on the heap.
+ *
+ * @tparam CAPACITY The number of bytes the ring can hold, must be a power of two.
+ */
+template <std::size_t CAPACITY>
+class spsc_ring
+{
+  static_assert(std::has_single_bit(CAPACITY), "The capacity of a ring must be a power of two.");
+
+  static constexpr std::size_t cache_line = 64;
+
+  // Total number of bytes published by the producer.
+  alignas(cache_line) std::atomic<std::size_t> head_{0};
+  // Incremented on every publication and on close, the consumer waits on it.
+  std::atomic<std::uint32_t> events_{0};
+  std::atomic<bool> closed_{false};
+  // Producer local state.
+  alignas(cache_line) std::size_t written_ = 0;
+  std::atomic<std::uint64_t> publications_{0};
+  std::atomic<std::uint64_t> producer_stalls_{0};
+
+  // Total number of bytes released by the consumer.
+  alignas(cache_line) std::atomic<std::size_t> tail_{0};
+  // Incremented on every release and on abort, the producer waits on it.
+  std::atomic<std::uint32_t> consumer_events_{0};
+  std::atomic<bool> aborted_{false};
+  // Consumer local state.
+  alignas(cache_line) std::atomic<std::uint64_t> records_parsed_{0};
+  std::atomic<std::uint64_t> consumer_waits_{0};
+
+  alignas(cache_line) std::array<std::byte, 2 * CAPACITY> storage_{};
+
+public:
+  spsc_ring() = default;
+  spsc_ring(const spsc_ring&) = delete;
+  spsc_ring& operator=(const spsc_ring&) = delete;
+
+  /**
+   * @return The number of bytes the ring can hold.
+   */
+  [[nodiscard]] static constexpr std::size_t capacity() { return CAPACITY; }
+
+  /**
+   * Copy bytes into the ring without making them visible to the consumer. Producer only.
+   * @param bytes The bytes to write.
+   * @return The number of bytes written, lower than bytes.size() if the ring is full.
+   */
+  std::size_t write(parse_input_t bytes)
+  {
+    const auto free = CAPACITY - (written_ - tail_.load(std::memory_order_acquire));
+    const auto n = std::min(free, bytes.size());
+    if (n < bytes.size())
+    {
+      producer_stalls_.fetch_add(1, std::memory_order_relaxed);
+    }
+    const auto position = written_ % CAPACITY;
+    const auto data = bytes.first(n);
+    std::copy(data.begin(), data.end(), std::next(storage_.begin(), static_cast<std::ptrdiff_t>(position)));
+    // Mirror the bytes in the other half of the storage.
+    const auto low = std::min(n, CAPACITY - position);
+    std::copy(
+      data.begin(), std::next(data.begin(), static_cast<std::ptrdiff_t>(low)),
+      std::next(storage_.begin(), static_cast<std::ptrdiff_t>(position + CAPACITY)));
+    std::copy(std::next(data.begin(), static_cast<std::ptrdiff_t>(low)), data.end(), storage_.begin());
+    written_ += n;
+    return n;
+  }
+
+  /**
+   * Make every written byte visible to the consumer. Producer only.
+   */
+  void publish()
+  {
+    if (written_ == head_.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    head_.store(written_, std::memory_order_release);
+    publications_.fetch_add(1, std::memory_order_relaxed);
+    events_.fetch_add(1, std::memory_order_release);
+    events_.notify_one();
+  }
+
+  /**
+   * Write and publish every byte, waiting for the consumer to free space when the ring is full. Producer only.
+   * @param bytes The bytes to write.
+   * @param policy How to wait for free space.
+   * @return False if the consumer aborted before every byte could be written.
+   */
+  bool write_all(parse_input_t bytes, wait_policy policy = wait_policy::blocking)
+  {
+    while (true)
+    {
+      bytes = bytes.subspan(write(bytes));
+      publish();
+      if (bytes.empty())
+      {
+        return true;
+      }
+      const auto events = consumer_events_.load(std::memory_order_acquire);
+      if (aborted_.load(std::memory_order_acquire))
+      {
+        return false;
+      }
+      if (written_ - tail_.load(std::memory_order_acquire) < CAPACITY)
+      {
+        continue;
+      }
+      if (policy == wait_policy::blocking)
+      {
+        consumer_events_.wait(events, std::memory_order_acquire);
+      }
+    }
+  }
+
+  /**
+   * Publish the remaining bytes and signal the consumer that no more data will come. Producer only.
+   */
+  void close()
+  {
+    publish();
+    closed_.store(true, std::memory_order_release);
+    events_.fetch_add(1, std::memory_order_release);
+    events_.notify_one();
+  }
+
+  /**
+   * @return The published bytes not yet released, as one contiguous region. Consumer only.
+   */
+  [[nodiscard]] parse_input_t readable() const
+  {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    return parse_input_t{storage_}.subspan(tail % CAPACITY, head - tail);
+  }
+
+  /**
+   * Give n readable bytes back to the producer. Consumer only.
+   * @param n The number of bytes to release, must not be greater than readable().size().
+   */
+  void release(std::size_t n)
+  {
+    if (n == 0)
+    {
+      return;
+    }
+    tail_.store(tail_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    consumer_events_.fetch_add(1, std::memory_order_release);
+    consumer_events_.notify_one();
+  }
+
+  /**
+   * Stop consuming the ring: the producer blocked in write_all() or calling it later returns false instead of
+   * waiting for free space. Consumer only.
+   */
+  void abort()
+  {
+    aborted_.store(true, std::memory_order_release);
+    consumer_events_.fetch_add(1, std::memory_order_release);
+    consumer_events_.notify_one();
+  }
+
+  /**
+   * @return True if the consumer aborted. Can be called from any thread.
+   */
+  [[nodiscard]] bool aborted() const { return aborted_.load(std::memory_order_acquire); }
+
+  /**
+   * Parse records from the readable bytes until the parser fails, then release the parsed bytes. Consumer only.
+   *
+   * A failure is expected when the last record is incomplete: its bytes stay in the ring until more data is
+   * published. If the parser fails on a full ring the stream is malformed and will never progress.
+   *
+   * @tparam P A parser of a: i -> optional<(a, i)>.
+   * @tparam C A callback receiving every parsed value: a -> void.
+   * @return The number of records parsed.
+   */
+  template <typename P, typename C>
+  std::size_t drain(const P& p, C&& consumer)
+  {
+    const auto input = readable();
+    auto remaining = input;
+    std::size_t records = 0;
+    while (auto r = p(remaining))
+    {
+      consumer(std::move(r->first));
+      remaining = r->second;
+      ++records;
+    }
+    release(input.size() - remaining.size());
+    records_parsed_.fetch_add(records, std::memory_order_relaxed);
+    return records;
+  }
+
+  /**
+   * Wait until more than `known` bytes are readable or the ring is closed. Consumer only.
+   * @param known The number of readable bytes already seen.
+   * @param policy How to wait.
+   * @return False if the ring is closed and no new byte was published.
+   */
+  bool wait_readable(std::size_t known, wait_policy policy = wait_policy::blocking)
+  {
+    auto has_new_data = [&] {
+      return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed) > known;
+    };
+    bool waited = false;
+    while (true)
+    {
+      const auto events = events_.load(std::memory_order_acquire);
+      if (has_new_data())
+      {
+        break;
+      }
+      if (closed_.load(std::memory_order_acquire))
+      {
+        // A last publication may have happened just before closing.
+        return has_new_data();
+      }
+      waited = true;
+      if (policy == wait_policy::blocking)
+      {
+        events_.wait(events, std::memory_order_acquire);
+      }
+    }
+    if (waited)
+    {
+      consumer_waits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  /**
+   * Parse records and hand them to the consumer until the producer closes the ring. Consumer only.
+   * @tparam P A parser of a: i -> optional<(a, i)>.
+   * @tparam C A callback receiving every parsed value: a -> void.
+   * @param policy How to wait for more data.
+   * @return The bytes left unparsed, empty unless the stream ends with a partial record or contains a malformed
+   * record (the parser fails on a full ring), in which case consumption stops early and the ring is aborted so
+   * that the producer does not wait for free space forever.
+   */
+  template <typename P, typename C>
+  parse_input_t consume(const P& p, C&& consumer, wait_policy policy = wait_policy::blocking)
+  {
+    do
+    {
+      drain(p, consumer);
+    } while (readable().size() < CAPACITY && wait_readable(readable().size(), policy));
+    if (readable().size() == CAPACITY)
+    {
+      abort();
+    }
+    return readable();
+  }
+
+  /**
+   * @return A snapshot of the ring counters. Can be called from any thread.
+   */
+  [[nodiscard]] ring_stats stats() const
+  {
+    return ring_stats{
+      .bytes_published = head_.load(std::memory_order_relaxed),
+      .publications = publications_.load(std::memory_order_relaxed),
+      .producer_stalls = producer_stalls_.load(std::memory_order_relaxed),
+      .records_parsed = records_parsed_.load(std::memory_order_relaxed),
+      .consumer_waits = consumer_waits_.load(std::memory_order_relaxed),
+    };
+  }
+};
+
+} // namespace parse_it
+
+#endif
@@ -0,0 +1,178 @@
+#pragma once
+#ifndef PARSE_IT_UTILS_CHECKSUM_H
+#define PARSE_IT_UTILS_CHECKSUM_H
+
+/**
+ * Checksum algorithms usable with the checksummed parser.
+ *
+ * Every algorithm provides a value_type and a static compute function: parse_input_t -> value_type.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+#include "../parser_types.h"
+
+namespace parse_it {
+
+namespace details {
+
+using crc_tables_t = std::array<std::array<std::uint32_t, 256>, 8>;
+
+// Generate the slicing-by-8 tables of a reflected CRC32 polynomial.
+constexpr crc_tables_t make_crc_tables(std::uint32_t polynomial)
+{
+  crc_tables_t tables{};
+  for (std::uint32_t i = 0; i < 256; ++i)
+  {
+    auto crc = i;
+    for (int bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+    }
+    tables[0][i] = crc;
+  }
+  for (std::size_t slice = 1; slice < tables.size(); ++slice)
+  {
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+      const auto previous = tables[slice - 1][i];
+      tables[slice][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+    }
+  }
+  return tables;
+}
+
+constexpr std::uint32_t load_u32_le(const std::byte* bytes)
+{
+  return std::to_integer<std::uint32_t>(bytes[0]) | std::to_integer<std::uint32_t>(bytes[1]) << 8
+         | std::to_integer<std::uint32_t>(bytes[2]) << 16 | std::to_integer<std::uint32_t>(bytes[3]) << 24;
+}
+
+// Table driven CRC32 processing 8 bytes per iteration.
+template <const crc_tables_t& TABLES>
+constexpr std::uint32_t crc32_slicing_by_8(std::uint32_t crc, parse_input_t data)
+{
+  const auto& t = TABLES;
+  auto it = data.data();
+  auto remaining = data.size();
+  for (; remaining >= 8; remaining -= 8, it += 8)
+  {
+    crc ^= load_u32_le(it);
+    const auto high = load_u32_le(it + 4);
+    crc = t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF] ^ t[5][(crc >> 16) & 0xFF] ^ t[4][crc >> 24]
+          ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+  }
+  for (; remaining > 0; --remaining, ++it)
+  {
+    crc = (crc >> 8) ^ t[0][(crc ^ std::to_integer<std::uint32_t>(*it)) & 0xFF];
+  }
+  return crc;
+}
+
+inline constexpr crc_tables_t crc32_tables = make_crc_tables(0xEDB88320);
+inline constexpr crc_tables_t crc32c_tables = make_crc_tables(0x82F63B78);
+
+} // namespace details
+
+/**
+ * CRC-32 (ISO-HDLC, as used by Ethernet and zlib).
+ */
+struct crc32
+{
+  using value_type = std::uint32_t;
+
+  static constexpr value_type compute(parse_input_t data)
+  {
+    return ~details::crc32_slicing_by_8<details::crc32_tables>(0xFFFFFFFF, data);
+  }
+};
+
+/**
+ * CRC-32C (Castagnoli, as used by iSCSI and SCTP).
+ *
+ * Uses the SSE4.2 crc32 instruction when the target supports it, by 8 byte words on x86-64 and by 4 byte words on
+ * 32 bits x86.
+ */
+struct crc32c
+{
+  using value_type = std::uint32_t;
+
+  static constexpr value_type compute(parse_input_t data)
+  {
+#if defined(__SSE4_2__)
+    if (!std::is_constant_evaluated())
+    {
+      auto it = data.data();
+      auto remaining = data.size();
+#if defined(__x86_64__) || defined(_M_X64)
+      std::uint64_t crc64 = 0xFFFFFFFF;
+      for (; remaining >= 8; remaining -= 8, it += 8)
+      {
+        std::uint64_t word;
+        std::memcpy(&word, it, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+      }
+      auto crc = static_cast<std::uint32_t>(crc64);
+#else
+      // The 8 byte form of the instruction only exists in 64 bits mode.
+      std::uint32_t crc = 0xFFFFFFFF;
+      for (; remaining >= 4; remaining -= 4, it += 4)
+      {
+        std::uint32_t word;
+        std::memcpy(&word, it, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+      }
+#endif
+      for (; remaining > 0; --remaining, ++it)
+      {
+        crc = _mm_crc32_u8(crc, std::to_integer<std::uint8_t>(*it));
+      }
+      return ~crc;
+    }
+#endif
+    return ~details::crc32_slicing_by_8<details::crc32c_tables>(0xFFFFFFFF, data);
+  }
+};
+
+/**
+ * Adler-32 (as used by zlib).
+ */
+struct adler32
+{
+  using value_type = std::uint32_t;
+
+  static constexpr value_type compute(parse_input_t data)
+  {
+    constexpr std::uint32_t modulo = 65521;
+    // Largest number of bytes which can be summed before a and b overflow.
+    constexpr std::size_t block_size = 5552;
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    while (!data.empty())
+    {
+      const auto block = data.first(std::min(block_size, data.size()));
+      for (const auto byte : block)
+      {
+        a += std::to_integer<std::uint32_t>(byte);
+        b += a;
+      }
+      a %= modulo;
+      b %= modulo;
+      data = data.subspan(block.size());
+    }
+    return b << 16 | a;
+  }
+};
+
+} // namespace parse_it
+
+#endif
@@ -0,0 +1,353 @@
+#pragma once
+#ifndef PARSE_IT_UTILS_INTERN_TABLE_H
+#define PARSE_IT_UTILS_INTERN_TABLE_H
+
+/**
+ * Tables interning short byte strings (symbols, identifiers), usable with the interned parser.
+ *
+ * Every table provides: intern(parse_input_t) -> interned_symbol.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "../parser_types.h"
+
+namespace parse_it {
+
+/**
+ * A symbol stored in an intern table: a small integer id, dense from 0 in insertion order, and the interned bytes,
+ * which stay valid as long as the table.
+ */
+struct interned_symbol
+{
+  std::uint32_t id = 0;
+  parse_input_t bytes;
+
+  /**
+   * @return The interned bytes as a string.
+   */
+  [[nodiscard]] std::string_view text() const
+  {
+    return std::string_view{reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+  }
+
+  friend bool operator==(const interned_symbol& lhs, const interned_symbol& rhs) { return lhs.id == rhs.id; }
+};
+
+namespace details {
+
+constexpr std::uint64_t mix_hash(std::uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCD;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53;
+  h ^= h >> 33;
+  return h;
+}
+
+inline std::uint64_t load_word(const std::byte* bytes, std::size_t size)
+{
+  std::uint64_t word = 0;
+  std::memcpy(&word, bytes, size);
+  return word;
+}
+
+/**
+ * Hash of a byte string, fast for short keys.
+ *
+ * The key is read by 8 byte words and its tail with one load overlapping the previous word, so keys of up to 16
+ * bytes are hashed with at most two loads and no per byte loop.
+ */
+inline std::uint64_t hash_bytes(parse_input_t key)
+{
+  const auto size = key.size();
+  auto h = mix_hash(size * 0x9E3779B97F4A7C15);
+  if (size == 0)
+  {
+    return h;
+  }
+  if (size < 8)
+  {
+    return mix_hash(h ^ load_word(key.data(), size));
+  }
+  auto it = key.data();
+  for (auto remaining = size; remaining > 8; remaining -= 8, it += 8)
+  {
+    h = mix_hash(h ^ load_word(it, 8));
+  }
+  return mix_hash(h ^ load_word(key.data() + size - 8, 8));
+}
+
+} // namespace details
+
+/**
+ * An open addressing intern table, not thread safe.
+ *
+ * Slots are 8 bytes (a hash tag and an id) probed linearly, so most lookups touch a single cache line and compare
+ * the bytes of a symbol only when the tags match. Interned bytes are copied into chunks which are never moved, so
+ * the returned symbols stay valid when the table grows.
+ */
+class intern_table
+{
+  static constexpr std::size_t chunk_size = 4096;
+
+  struct slot
+  {
+    std::uint32_t tag = 0;
+    // Id of the symbol plus one, 0 for an empty slot.
+    std::uint32_t id = 0;
+  };
+
+  struct entry
+  {
+    parse_input_t bytes;
+    std::uint64_t hash;
+  };
+
+  std::vector<slot> slots_;
+  std::vector<entry> entries_;
+  std::vector<std::unique_ptr<std::byte[]>> chunks_;
+  std::size_t chunk_used_ = chunk_size;
+
+  static std::uint32_t tag_of(std::uint64_t hash) { return static_cast<std::uint32_t>(hash >> 32); }
+
+  [[nodiscard]] std::size_t mask() const { return slots_.size() - 1; }
+
+  // First slot probed for a hash.
+  [[nodiscard]] std::size_t home_of(std::uint64_t hash) const { return hash & mask(); }
+
+  // Find the slot of a key or the empty slot where it should be inserted.
+  [[nodiscard]] std::size_t probe(parse_input_t key, std::uint64_t hash) const
+  {
+    const auto tag = tag_of(hash);
+    for (auto i = home_of(hash);; i = (i + 1) & mask())
+    {
+      const auto& s = slots_[i];
+      if (s.id == 0)
+      {
+        return i;
+      }
+      if (s.tag == tag)
+      {
+        const auto& stored = entries_[s.id - 1].bytes;
+        if (std::equal(stored.begin(), stored.end(), key.begin(), key.end()))
+        {
+          return i;
+        }
+      }
+    }
+  }
+
+  parse_input_t store(parse_input_t bytes)
+  {
+    if (bytes.empty())
+    {
+      return {};
+    }
+    if (bytes.size() > chunk_size / 4)
+    {
+      auto& chunk = chunks_.emplace_back(std::make_unique<std::byte[]>(bytes.size()));
+      std::copy(bytes.begin(), bytes.end(), chunk.get());
+      return parse_input_t{chunk.get(), bytes.size()};
+    }
+    if (chunk_size - chunk_used_ < bytes.size())
+    {
+      chunks_.push_back(std::make_unique<std::byte[]>(chunk_size));
+      chunk_used_ = 0;
+    }
+    const auto destination = chunks_.back().get() + chunk_used_;
+    std::copy(bytes.begin(), bytes.end(), destination);
+    chunk_used_ += bytes.size();
+    return parse_input_t{destination, bytes.size()};
+  }
+
+  void grow()
+  {
+    slots_.assign(slots_.size() * 2, slot{});
+    for (std::size_t id = 0; id < entries_.size(); ++id)
+    {
+      const auto hash = entries_[id].hash;
+      auto i = home_of(hash);
+      while (slots_[i].id != 0)
+      {
+        i = (i + 1) & mask();
+      }
+      slots_[i] = slot{tag_of(hash), static_cast<std::uint32_t>(id + 1)};
+    }
+  }
+
+public:
+  /**
+   * @param expected_size The number of symbols the table can hold before growing.
+   */
+  explicit intern_table(std::size_t expected_size = 64)
+      : slots_(std::bit_ceil(std::max<std::size_t>(expected_size * 2, 16)))
+  {
+    entries_.reserve(expected_size);
+  }
+
+  intern_table(const intern_table&) = delete;
+  intern_table& operator=(const intern_table&) = delete;
+
+  /**
+   * @return The number of interned symbols.
+   */
+  [[nodiscard]] std::size_t size() const { return entries_.size(); }
+
+  /**
+   * Intern a byte string, copying it on its first occurrence only.
+   * @param bytes The bytes to intern.
+   * @return The symbol of bytes.
+   */
+  interned_symbol intern(parse_input_t bytes) { return intern(bytes, details::hash_bytes(bytes)); }
+
+  /**
+   * Intern a byte string whose hash (as computed by details::hash_bytes) is already known.
+   */
+  interned_symbol intern(parse_input_t bytes, std::uint64_t hash)
+  {
+    auto i = probe(bytes, hash);
+    if (slots_[i].id == 0)
+    {
+      // Keep the load factor under 1/2 so that probe sequences stay short.
+      if ((entries_.size() + 1) * 2 > slots_.size())
+      {
+        grow();
+        i = probe(bytes, hash);
+      }
+      entries_.push_back(entry{store(bytes), hash});
+      slots_[i] = slot{tag_of(hash), static_cast<std::uint32_t>(entries_.size())};
+    }
+    const auto id = slots_[i].id - 1;
+    return interned_symbol{id, entries_[id].bytes};
+  }
+
+  /**
+   * Look up a byte string without interning it.
+   * @param bytes The bytes to look up.
+   * @return The symbol of bytes, nullopt if they were never interned.
+   */
+  [[nodiscard]] std::optional<interned_symbol> find(parse_input_t bytes) const
+  {
+    const auto i = probe(bytes, details::hash_bytes(bytes));
+    if (slots_[i].id == 0)
+    {
+      return std::nullopt;
+    }
+    const auto id = slots_[i].id - 1;
+    return interned_symbol{id, entries_[id].bytes};
+  }
+
+  /**
+   * @param id The id of an interned symbol.
+   * @return The symbol of that id.
+   */
+  [[nodiscard]] interned_symbol symbol(std::uint32_t id) const { return interned_symbol{id, entries_[id].bytes}; }
+};
+
+/**
+ * An intern table shared by several threads.
+ *
+ * Insertions and lookups missing the front cache are serialized by a mutex. Each thread keeps a small direct mapped
+ * front cache of the symbols it recently looked up, so that the frequent symbols are found without touching the
+ * shared table. Symbols are never removed, so cached symbols never become stale.
+ *
+ * @tparam FRONT_CACHE_SIZE The number of entries of the per thread front cache, a power of two or 0 to disable it.
+ */
+template <std::size_t FRONT_CACHE_SIZE = 256>
+class concurrent_intern_table
+{
+  static_assert(
+    FRONT_CACHE_SIZE == 0 || std::has_single_bit(FRONT_CACHE_SIZE),
+    "The size of the front cache must be a power of two.");
+
+  struct cached_symbol
+  {
+    // Identifies the table owning the symbol, 0 for an empty entry.
+    std::uint64_t table_id = 0;
+    std::uint64_t hash = 0;
+    interned_symbol symbol;
+  };
+
+  static std::uint64_t next_table_id()
+  {
+    static std::atomic<std::uint64_t> last_id{0};
+    return ++last_id;
+  }
+
+  const std::uint64_t table_id_ = next_table_id();
+  mutable std::mutex mutex_;
+  intern_table table_;
+
+public:
+  /**
+   * @param expected_size The number of symbols the table can hold before growing.
+   */
+  explicit concurrent_intern_table(std::size_t expected_size = 64)
+      : table_{expected_size}
+  {}
+
+  /**
+   * @return The number of interned symbols.
+   */
+  [[nodiscard]] std::size_t size() const
+  {
+    const auto lock = std::scoped_lock{mutex_};
+    return table_.size();
+  }
+
+  /**
+   * Intern a byte string, copying it on its first occurrence only.
+   * @param bytes The bytes to intern.
+   * @return The symbol of bytes.
+   */
+  interned_symbol intern(parse_input_t bytes)
+  {
+    const auto hash = details::hash_bytes(bytes);
+    if constexpr (FRONT_CACHE_SIZE > 0)
+    {
+      thread_local std::array<cached_symbol, FRONT_CACHE_SIZE> front_cache{};
+      auto& cached = front_cache[hash & (FRONT_CACHE_SIZE - 1)];
+      if (
+        cached.table_id == table_id_ && cached.hash == hash
+        && std::equal(cached.symbol.bytes.begin(), cached.symbol.bytes.end(), bytes.begin(), bytes.end()))
+      {
+        return cached.symbol;
+      }
+      const auto lock = std::scoped_lock{mutex_};
+      cached = cached_symbol{table_id_, hash, table_.intern(bytes, hash)};
+      return cached.symbol;
+    }
+    else
+    {
+      const auto lock = std::scoped_lock{mutex_};
+      return table_.intern(bytes, hash);
+    }
+  }
+
+  /**
+   * @param id The id of an interned symbol.
+   * @return The symbol of that id.
+   */
+  [[nodiscard]] interned_symbol symbol(std::uint32_t id) const
+  {
+    const auto lock = std::scoped_lock{mutex_};
+    return table_.symbol(id);
+  }
+};
+
+} // namespace parse_it
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef PARSE_IT_UTILS_STATIC_VECTOR_H
+#define PARSE_IT_UTILS_STATIC_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+namespace parse_it {
+
+/**
+ * A vector with a fixed capacity storing its elements inline, without heap allocation.
+ *
+ * Elements are default constructed in the inline storage and assigned when pushed.
+ *
+ * @tparam T The type of the elements, must be default constructible.
+ * @tparam N The capacity of the vector.
+ */
+template <typename T, std::size_t N>
+class static_vector
+{
+  std::array<T, N> storage_{};
+  std::size_t size_ = 0;
+
+public:
+  using value_type = T;
+  using iterator = typename std::array<T, N>::iterator;
+  using const_iterator = typename std::array<T, N>::const_iterator;
+
+  constexpr static_vector() = default;
+
+  [[nodiscard]] static constexpr std::size_t capacity() { return N; }
+  [[nodiscard]] constexpr std::size_t size() const { return size_; }
+  [[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+  [[nodiscard]] constexpr bool full() const { return size_ == N; }
+
+  /**
+   * Append an element, the vector must not be full.
+   * @param value The element to append.
+   */
+  constexpr void push_back(T value) { storage_[size_++] = std::move(value); }
+
+  constexpr T& operator[](std::size_t i) { return storage_[i]; }
+  constexpr const T& operator[](std::size_t i) const { return storage_[i]; }
+
+  constexpr T* data() { return storage_.data(); }
+  constexpr const T* data() const { return storage_.data(); }
+
+  constexpr iterator begin() { return storage_.begin(); }
+  constexpr iterator end() { return std::next(storage_.begin(), static_cast<std::ptrdiff_t>(size_)); }
+  constexpr const_iterator begin() const { return storage_.begin(); }
+  constexpr const_iterator end() const { return std::next(storage_.begin(), static_cast<std::ptrdiff_t>(size_)); }
+
+  friend constexpr bool operator==(const static_vector& lhs, const static_vector& rhs)
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+};
+
+} // namespace parse_it
+
+#endif
@@ -36,3 +36,11 @@ TEST_CASE("Any byte parser")
     REQUIRE(!result);
   }
 }
+
+TEST_CASE("Any byte parser at compile time")
+{
+  static constexpr auto data = std::array{0x7_b};
+
+  static_assert(any_byte()(data)->first == 0x7_b);
+  static_assert(!any_byte()(std::span(data).subspan(1)));
+}
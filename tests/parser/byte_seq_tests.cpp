@@ -52,4 +52,12 @@ TEST_CASE("Byte sequence parser")
 
     REQUIRE(!result);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Byte sequence parser at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x2_b, 0x3_b};
+
+  static_assert(byte_seq(std::array{0x1_b, 0x2_b})(data)->second.size() == 1);
+  static_assert(!byte_seq(std::array{0x2_b, 0x3_b})(data));
+}
@@ -0,0 +1,94 @@
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+namespace {
+std::vector<std::byte> bytes_of(std::string_view s)
+{
+  auto bytes = std::vector<std::byte>{};
+  for (const auto c : s)
+  {
+    bytes.push_back(static_cast<std::byte>(c));
+  }
+  return bytes;
+}
+} // namespace
+
+TEST_CASE("Checksum algorithms")
+{
+  const auto check = bytes_of("123456789");
+
+  SUBCASE("compute the standard check values.")
+  {
+    REQUIRE(crc32::compute(check) == 0xCBF43926);
+    REQUIRE(crc32c::compute(check) == 0xE3069283);
+    REQUIRE(adler32::compute(check) == 0x091E01DE);
+  }
+
+  SUBCASE("handle empty inputs.")
+  {
+    REQUIRE(crc32::compute({}) == 0);
+    REQUIRE(crc32c::compute({}) == 0);
+    REQUIRE(adler32::compute({}) == 1);
+  }
+
+  SUBCASE("handle inputs larger than one processing block.")
+  {
+    const auto large = std::vector<std::byte>(10000, 0xFF_b);
+    REQUIRE(crc32::compute(large) == 0x133C790D);
+    REQUIRE(adler32::compute(large) == 0xB623EB2B);
+  }
+}
+
+TEST_CASE("Checksummed parser")
+{
+  constexpr auto parser = checksummed<crc32>(n_bytes(9));
+  auto data = bytes_of("123456789");
+  const auto trailer = std::array{0xCB_b, 0xF4_b, 0x39_b, 0x26_b, 0x42_b};
+  data.insert(data.end(), trailer.begin(), trailer.end());
+
+  SUBCASE("succeeds when the checksum matches")
+  {
+    const auto result = parser(data);
+    REQUIRE(result);
+
+    SUBCASE("and returns the result of the parser.") { REQUIRE(result->first.size() == 9); }
+
+    SUBCASE("and consumes the checksum.") { REQUIRE(result->second.size() == 1); }
+  }
+
+  SUBCASE("fails when the checksum does not match.")
+  {
+    data[0] = 0x30_b;
+    REQUIRE(!parser(data));
+  }
+
+  SUBCASE("fails when the checksum is missing.") { REQUIRE(!parser(std::span(data).first(11))); }
+
+  SUBCASE("reads the checksum with the given endianness.")
+  {
+    auto little = bytes_of("123456789");
+    const auto little_trailer = std::array{0x83_b, 0x92_b, 0x06_b, 0xE3_b};
+    little.insert(little.end(), little_trailer.begin(), little_trailer.end());
+    REQUIRE(checksummed<crc32c, std::endian::little>(n_bytes(9))(little));
+  }
+}
+
+TEST_CASE("Checksummed parser at compile time")
+{
+  static constexpr auto data = std::array{'1'_b, '2'_b, '3'_b, 0x1_b, 0x2D_b, 0x00_b, 0x97_b};
+  static constexpr auto check = std::array{'1'_b, '2'_b, '3'_b, '4'_b, '5'_b, '6'_b, '7'_b, '8'_b, '9'_b};
+
+  static_assert(adler32::compute(std::span(data).first(3)) == 0x012D0097);
+  static_assert(checksummed<adler32>(n_bytes(3))(data));
+  static_assert(crc32::compute(check) == 0xCBF43926);
+  static_assert(crc32c::compute(check) == 0xE3069283);
+}
@@ -45,3 +45,43 @@ TEST_CASE("combine parser")
     REQUIRE(!result);
   }
 }
+
+TEST_CASE("combine parser with user defined parsers")
+{
+  const auto user_parser = [](parse_input_t input) -> parse_result_t<int> {
+    if (input.size() < 2)
+    {
+      return std::nullopt;
+    }
+    return std::pair(std::to_integer<int>(input[0]) * std::to_integer<int>(input[1]), input.subspan(2));
+  };
+  const auto parser =
+    combine([](int product, std::byte b) { return product + std::to_integer<int>(b); }, user_parser, any_byte());
+
+  SUBCASE("succeeds and consumes the bytes consumed by every parser.")
+  {
+    constexpr auto data = std::array{0x2_b, 0x3_b, 0x4_b, 0x5_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+    REQUIRE(result->first == 10);
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("fails if the user defined parser fails.")
+  {
+    constexpr auto data = std::array{0x2_b};
+    REQUIRE(!parser(data));
+  }
+}
+
+TEST_CASE("combine parser at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x2_b, 0x3_b, 0x4_b};
+  constexpr auto parser = combine(
+    [](auto first, auto, auto second) { return std::to_integer<int>(first) + std::to_integer<int>(second); },
+    one_byte(0x01_b), skip(1), one_byte(0x03_b));
+
+  static_assert(parser(data)->first == 4);
+  static_assert(parser(data)->second.size() == 1);
+  static_assert(!parser(std::span(data).subspan(1)));
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <array>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+TEST_CASE("Count parser")
+{
+  constexpr auto parser = count<3>(arithmetic_parser<std::uint16_t>());
+
+  SUBCASE("succeeds when the parser succeeds N times")
+  {
+    constexpr auto data = std::array{0x0_b, 0x1_b, 0x0_b, 0x2_b, 0x0_b, 0x3_b, 0x4_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+
+    SUBCASE("and returns every parsed value.") { REQUIRE(result->first == std::array<std::uint16_t, 3>{1, 2, 3}); }
+
+    SUBCASE("and consumes the parsed bytes.") { REQUIRE(result->second.size() == 1); }
+  }
+
+  SUBCASE("knows the minimum size of its input.") { REQUIRE(parser.min_size() == 6); }
+
+  SUBCASE("fails if input is too small.")
+  {
+    constexpr auto data = std::array{0x0_b, 0x1_b, 0x0_b, 0x2_b, 0x0_b};
+    REQUIRE(!parser(data));
+  }
+
+  SUBCASE("fails if one repetition fails.")
+  {
+    constexpr auto ones = count<3>(one_byte(0x1_b));
+    constexpr auto data = std::array{0x1_b, 0x1_b, 0x2_b};
+    REQUIRE(!ones(data));
+  }
+}
+
+TEST_CASE("Count parser into a caller provided buffer")
+{
+  auto buffer = std::array<std::byte, 4>{};
+  const auto parser = count(std::span(buffer).first(2), any_byte());
+
+  SUBCASE("succeeds when the parser succeeds once per element")
+  {
+    constexpr auto data = std::array{0x5_b, 0x6_b, 0x7_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+
+    SUBCASE("and stores the parsed values in the buffer.")
+    {
+      REQUIRE(result->first.data() == buffer.data());
+      REQUIRE(std::ranges::equal(result->first, std::array{0x5_b, 0x6_b}));
+    }
+
+    SUBCASE("and consumes the parsed bytes.") { REQUIRE(result->second.size() == 1); }
+  }
+
+  SUBCASE("fails if input is too small.")
+  {
+    constexpr auto data = std::array{0x5_b};
+    REQUIRE(!parser(data));
+  }
+}
+
+TEST_CASE("Count parsers at compile time")
+{
+  static constexpr auto data = std::array{0x0_b, 0x1_b, 0x0_b, 0x2_b};
+
+  static_assert(count<2>(arithmetic_parser<std::uint16_t>())(data)->first == std::array<std::uint16_t, 2>{1, 2});
+  static_assert(!count<3>(arithmetic_parser<std::uint16_t>())(data));
+  static_assert(many_max<3>(any_byte())(data)->first.size() == 3);
+  static_assert(sep_by(any_byte(), one_byte(0x1_b), 0, [](int acc, std::byte) { return acc + 1; })(data)->first == 2);
+}
@@ -0,0 +1,80 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "parse_it/layout.h"
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+TEST_CASE("Record layout")
+{
+  using layout = record_layout<column<std::uint32_t>, padding<2>, column<std::uint16_t, std::endian::little>>;
+
+  SUBCASE("computes the record size.") { REQUIRE(layout::size == 8); }
+
+  SUBCASE("computes the field offsets.") { REQUIRE(layout::offsets == std::array<std::size_t, 3>{0, 4, 6}); }
+}
+
+TEST_CASE("Columnar decoding")
+{
+  constexpr auto layout =
+    record_layout<column<std::uint32_t>, padding<2>, column<std::uint16_t, std::endian::little>>{};
+  constexpr std::size_t records = 1000;
+  auto data = std::vector<std::byte>{};
+  for (std::size_t i = 0; i < records * decltype(layout)::size + 3; ++i)
+  {
+    data.push_back(static_cast<std::byte>(i * 7));
+  }
+
+  SUBCASE("decodes every record into its columns")
+  {
+    auto ids = std::vector<std::uint32_t>(records);
+    auto sizes = std::vector<std::uint16_t>(records);
+    const auto result = decode_columns(layout, data, std::span(ids), std::span(sizes));
+    REQUIRE(result);
+    REQUIRE(result->first == records);
+    REQUIRE(result->second.size() == 3);
+
+    SUBCASE("with the same values as a row by row parser.")
+    {
+      const auto row = combine(
+        [](std::uint32_t id, unit, std::uint16_t size) { return std::pair(id, size); },
+        arithmetic_parser<std::uint32_t>(), skip(2), arithmetic_parser<std::uint16_t, std::endian::little>());
+      auto input = parse_input_t{data};
+      for (std::size_t i = 0; i < records; ++i)
+      {
+        const auto r = row(input);
+        REQUIRE(r);
+        REQUIRE(ids[i] == r->first.first);
+        REQUIRE(sizes[i] == r->first.second);
+        input = r->second;
+      }
+    }
+  }
+
+  SUBCASE("stops when a column is full.")
+  {
+    auto ids = std::vector<std::uint32_t>(10);
+    auto sizes = std::vector<std::uint16_t>(records);
+    const auto result = decode_columns(layout, data, std::span(ids), std::span(sizes));
+    REQUIRE(result->first == 10);
+    REQUIRE(result->second.size() == data.size() - 10 * decltype(layout)::size);
+  }
+}
+
+TEST_CASE("Columnar decoding at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x2_b, 0x0_b, 0x3_b, 0x4_b, 0x0_b};
+  constexpr auto decoded = [] {
+    auto values = std::array<std::uint16_t, 2>{};
+    decode_columns(record_layout<column<std::uint16_t>, padding<1>>{}, data, std::span<std::uint16_t>(values));
+    return values;
+  }();
+
+  static_assert(decoded == std::array<std::uint16_t, 2>{0x0102, 0x0304});
+}
@@ -0,0 +1,145 @@
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+#include "parse_it/utils/checksum.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+namespace {
+struct point
+{
+  std::uint16_t x;
+  std::int32_t y;
+
+  bool operator==(const point&) const = default;
+};
+
+constexpr auto point_parser = fmap(
+  [](std::tuple<std::uint16_t, std::int32_t> t) { return point{std::get<0>(t), std::get<1>(t)}; },
+  [](const point& p) { return std::tuple{p.x, p.y}; },
+  combine(
+    [](std::uint16_t x, std::int32_t y) { return std::tuple{x, y}; },
+    arithmetic_parser<std::uint16_t>(),
+    arithmetic_parser<std::int32_t, std::endian::little>()));
+} // namespace
+
+TEST_CASE("Encode")
+{
+  auto buffer = std::array<std::byte, 16>{};
+
+  SUBCASE("writes the bytes of the primitive parsers.")
+  {
+    const auto parser = combine(
+      [](auto... values) { return std::tuple{values...}; },
+      one_byte(0x01_b),
+      any_byte(),
+      byte_seq(std::array{0x02_b, 0x03_b}),
+      skip(2),
+      arithmetic_parser<std::uint16_t>());
+    const auto value = std::tuple{0x01_b, 0xAA_b, std::array{0x02_b, 0x03_b}, unit{}, std::uint16_t{0x1234}};
+
+    REQUIRE(encoded_size(parser, value) == 8);
+    const auto rest = encode(parser, value, buffer);
+    REQUIRE(rest);
+    REQUIRE(rest->size() == buffer.size() - 8);
+    const auto expected = std::array{0x01_b, 0xAA_b, 0x02_b, 0x03_b, 0x00_b, 0x00_b, 0x12_b, 0x34_b};
+    REQUIRE(std::equal(expected.begin(), expected.end(), buffer.begin()));
+  }
+
+  SUBCASE("round trips through fmap with an inverse function.")
+  {
+    const auto value = point{0xBEEF, -2};
+    const auto rest = encode(point_parser, value, buffer);
+    REQUIRE(rest);
+    const auto encoded = parse_input_t{buffer}.first(buffer.size() - rest->size());
+    REQUIRE(encoded.size() == 6);
+
+    const auto result = point_parser(encoded);
+    REQUIRE(result);
+    REQUIRE(result->first == value);
+    REQUIRE(result->second.empty());
+  }
+
+  SUBCASE("round trips ranges of values.")
+  {
+    const auto parser = many(
+      arithmetic_parser<std::uint16_t, std::endian::little>(),
+      std::vector<std::uint16_t>{},
+      [](auto values, auto v) {
+        values.push_back(v);
+        return values;
+      });
+    const auto values = std::vector<std::uint16_t>{1, 2, 0xFFFF};
+    REQUIRE(encoded_size(parser, values) == 6);
+    const auto rest = encode(parser, values, buffer);
+    REQUIRE(rest);
+
+    const auto result = parser(parse_input_t{buffer}.first(6));
+    REQUIRE(result);
+    REQUIRE(result->first == values);
+  }
+
+  SUBCASE("rejects ranges of the wrong size.")
+  {
+    const auto exactly_two = count<2>(any_byte());
+    const auto at_most_two = many_max<2>(any_byte());
+    REQUIRE(encoded_size(exactly_two, std::array{0x01_b, 0x02_b}) == 2);
+    REQUIRE_FALSE(encoded_size(exactly_two, std::vector{0x01_b}));
+    REQUIRE(encoded_size(at_most_two, std::vector{0x01_b}) == 1);
+    REQUIRE_FALSE(encode(at_most_two, std::vector{0x01_b, 0x02_b, 0x03_b}, buffer));
+  }
+
+  SUBCASE("rejects values the parser cannot produce.")
+  {
+    REQUIRE(encode(one_byte(0x01_b), 0x01_b, buffer));
+    REQUIRE_FALSE(encode(one_byte(0x01_b), 0x02_b, buffer));
+    REQUIRE(encode(byte_seq(std::array{0x01_b, 0x02_b}), std::array{0x01_b, 0x02_b}, buffer));
+    REQUIRE_FALSE(encode(byte_seq(std::array{0x01_b, 0x02_b}), std::array{0x01_b, 0x03_b}, buffer));
+    REQUIRE_FALSE(encode(byte_seq(std::array{0x01_b, 0x02_b}), std::array{0x01_b}, buffer));
+  }
+
+  SUBCASE("rejects byte spans of the wrong size.")
+  {
+    const auto bytes = std::array{0x01_b, 0x02_b, 0x03_b};
+    REQUIRE(encode(n_bytes(3), std::span<const std::byte>{bytes}, buffer));
+    REQUIRE_FALSE(encode(n_bytes(2), std::span<const std::byte>{bytes}, buffer));
+  }
+
+  SUBCASE("fails without writing when the output is too small.")
+  {
+    auto small = std::array<std::byte, 5>{};
+    REQUIRE_FALSE(encode(point_parser, point{1, 2}, small));
+    REQUIRE(small == std::array<std::byte, 5>{});
+  }
+
+  SUBCASE("computes checksums.")
+  {
+    const auto parser = checksummed<crc32>(arithmetic_parser<std::uint32_t>());
+    REQUIRE(encoded_size(parser, std::uint32_t{42}) == 8);
+    const auto rest = encode(parser, std::uint32_t{42}, buffer);
+    REQUIRE(rest);
+
+    const auto result = parser(parse_input_t{buffer}.first(8));
+    REQUIRE(result);
+    REQUIRE(result->first == 42);
+  }
+}
+
+TEST_CASE("Encode at compile time")
+{
+  constexpr auto encoded = [] {
+    auto buffer = std::array<std::byte, 6>{};
+    encode(point_parser, point{0x0102, 0x03040506}, buffer);
+    return buffer;
+  }();
+  static_assert(encoded == std::array{0x01_b, 0x02_b, 0x06_b, 0x05_b, 0x04_b, 0x03_b});
+  static_assert(point_parser(encoded)->first == point{0x0102, 0x03040506});
+  REQUIRE(encoded[0] == 0x01_b);
+}
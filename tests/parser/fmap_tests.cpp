@@ -22,3 +22,12 @@ TEST_CASE("fmap parser")
     SUBCASE("and returns F applied to the first parser result.") { REQUIRE(result->first == 500); }
   }
 }
+
+TEST_CASE("fmap parser at compile time")
+{
+  static constexpr auto data = std::array{0x5_b};
+  constexpr auto parser = fmap([](std::byte b) { return std::to_integer<uint32_t>(b) * 100; }, any_byte());
+
+  static_assert(parser(data)->first == 500);
+  static_assert(!parser(std::span(data).subspan(1)));
+}
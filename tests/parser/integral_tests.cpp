@@ -181,3 +181,13 @@ TEST_CASE("Uint64 parser big endian")
     REQUIRE(!result);
   }
 }
+
+TEST_CASE("Arithmetic parsers at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x2_b, 0x3_b, 0x4_b};
+
+  static_assert(arithmetic_parser<std::uint16_t>()(data)->first == 0x0102);
+  static_assert(arithmetic_parser<std::uint32_t, std::endian::little>()(data)->first == 0x04030201);
+  static_assert(arithmetic_parser<std::int8_t>()(data)->second.size() == 3);
+  static_assert(!arithmetic_parser<std::uint64_t>()(data));
+}
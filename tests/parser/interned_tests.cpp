@@ -0,0 +1,164 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+#include "parse_it/utils/intern_table.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+namespace {
+parse_input_t bytes_of(std::string_view s) { return std::as_bytes(std::span{s.data(), s.size()}); }
+} // namespace
+
+TEST_CASE("Intern table")
+{
+  auto table = intern_table{4};
+
+  SUBCASE("returns the same symbol for equal bytes.")
+  {
+    const auto first = table.intern(bytes_of("AAPL"));
+    const auto second = table.intern(bytes_of(std::string{"AAPL"}));
+    REQUIRE(first.id == 0);
+    REQUIRE(second == first);
+    REQUIRE(second.bytes.data() == first.bytes.data());
+    REQUIRE(table.intern(bytes_of("MSFT")).id == 1);
+    REQUIRE(table.size() == 2);
+  }
+
+  SUBCASE("keeps symbols valid when growing.")
+  {
+    const auto first = table.intern(bytes_of("first"));
+    auto names = std::vector<std::string>{};
+    for (int i = 0; i < 1000; ++i)
+    {
+      names.push_back("symbol-" + std::to_string(i));
+      REQUIRE(table.intern(bytes_of(names.back())).id == static_cast<std::uint32_t>(i + 1));
+    }
+    REQUIRE(first.text() == "first");
+    REQUIRE(table.size() == 1001);
+    for (int i = 0; i < 1000; ++i)
+    {
+      const auto symbol = table.find(bytes_of(names[static_cast<std::size_t>(i)]));
+      REQUIRE(symbol);
+      REQUIRE(symbol->id == static_cast<std::uint32_t>(i + 1));
+      REQUIRE(symbol->text() == names[static_cast<std::size_t>(i)]);
+    }
+  }
+
+  SUBCASE("finds only interned bytes.")
+  {
+    table.intern(bytes_of("AAPL"));
+    REQUIRE(table.find(bytes_of("AAPL")));
+    REQUIRE_FALSE(table.find(bytes_of("AAP")));
+    REQUIRE_FALSE(table.find(bytes_of("")));
+    REQUIRE(table.symbol(0).text() == "AAPL");
+  }
+
+  SUBCASE("interns empty byte strings.")
+  {
+    const auto empty = table.intern(parse_input_t{});
+    REQUIRE(empty.bytes.empty());
+    REQUIRE(table.intern(bytes_of("")) == empty);
+    REQUIRE(table.intern(bytes_of("AAPL")).id == 1);
+    REQUIRE(table.size() == 2);
+  }
+
+  SUBCASE("stores long byte strings.")
+  {
+    const auto long_name = std::string(5000, 'x');
+    const auto symbol = table.intern(bytes_of(long_name));
+    REQUIRE(symbol.text() == long_name);
+    REQUIRE(table.intern(bytes_of(long_name)) == symbol);
+  }
+}
+
+TEST_CASE("Interned parser")
+{
+  auto table = intern_table{};
+  const auto parser = interned(n_bytes(4), table);
+  const auto input = std::array{0x41_b, 0x41_b, 0x50_b, 0x4C_b, 0x41_b, 0x41_b, 0x50_b, 0x4C_b};
+
+  SUBCASE("interns the parsed bytes.")
+  {
+    const auto first = parser(input);
+    REQUIRE(first);
+    REQUIRE(first->first.text() == "AAPL");
+    const auto second = parser(first->second);
+    REQUIRE(second);
+    REQUIRE(second->first == first->first);
+    REQUIRE(second->second.empty());
+    REQUIRE(table.size() == 1);
+  }
+
+  SUBCASE("interns empty fields.")
+  {
+    const auto empty = interned(n_bytes(0), table)(input);
+    REQUIRE(empty);
+    REQUIRE(empty->first.text().empty());
+    REQUIRE(empty->second.size() == input.size());
+  }
+
+  SUBCASE("fails when its parser fails.")
+  {
+    REQUIRE_FALSE(parser(parse_input_t{input}.first(3)));
+    REQUIRE(table.size() == 0);
+  }
+
+  SUBCASE("encodes the symbol bytes.")
+  {
+    auto buffer = std::array<std::byte, 4>{};
+    REQUIRE(encode(parser, table.intern(bytes_of("MSFT")), buffer));
+    REQUIRE(parser(buffer)->first.text() == "MSFT");
+  }
+}
+
+TEST_CASE("Concurrent intern table")
+{
+  auto table = concurrent_intern_table<>{};
+  auto names = std::vector<std::string>{};
+  for (int i = 0; i < 64; ++i)
+  {
+    names.push_back("S" + std::to_string(i));
+  }
+
+  auto ids = std::vector<std::vector<std::uint32_t>>(4);
+  auto threads = std::vector<std::thread>{};
+  for (auto& thread_ids : ids)
+  {
+    threads.emplace_back([&] {
+      for (int round = 0; round < 100; ++round)
+      {
+        for (const auto& name : names)
+        {
+          const auto symbol = table.intern(bytes_of(name));
+          if (round == 0)
+          {
+            thread_ids.push_back(symbol.id);
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  REQUIRE(table.size() == names.size());
+  for (const auto& thread_ids : ids)
+  {
+    REQUIRE(thread_ids == ids.front());
+  }
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    REQUIRE(table.symbol(ids.front()[i]).text() == names[i]);
+  }
+}
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <array>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+TEST_CASE("Many max parser")
+{
+  constexpr auto parser = many_max<2>(one_byte(0x1_b));
+
+  SUBCASE("stops after N repetitions.")
+  {
+    constexpr auto data = std::array{0x1_b, 0x1_b, 0x1_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+    REQUIRE(result->first.size() == 2);
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("stops when the parser fails.")
+  {
+    constexpr auto data = std::array{0x1_b, 0x2_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+    REQUIRE(std::ranges::equal(result->first, std::array{0x1_b}));
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("succeeds with no value if the parser fails instantly.")
+  {
+    constexpr auto data = std::array{0x2_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+    REQUIRE(result->first.empty());
+    REQUIRE(result->second.size() == 1);
+  }
+}
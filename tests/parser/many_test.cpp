@@ -32,3 +32,12 @@ TEST_CASE("Many return a parser accepting a repetition of the given parser.")
     CHECK(std::ranges::equal(result->second, expected_remaining));
   }
 }
+
+TEST_CASE("Many parser at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x1_b, 0x1_b, 0x2_b};
+  constexpr auto one_counter = many(one_byte(0x01_b), 0, [](auto acc, auto) { return ++acc; });
+
+  static_assert(one_counter(data)->first == 3);
+  static_assert(one_counter(data)->second.size() == 1);
+}
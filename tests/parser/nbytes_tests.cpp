@@ -32,3 +32,12 @@ TEST_CASE("N bytes parser")
     REQUIRE(!result);
   }
 }
+
+TEST_CASE("N bytes parser at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x2_b, 0x3_b};
+
+  static_assert(n_bytes(2)(data)->first.size() == 2);
+  static_assert(n_bytes(2)(data)->first[1] == 0x2_b);
+  static_assert(!n_bytes(4)(data));
+}
@@ -46,3 +46,11 @@ TEST_CASE("One byte parser")
     REQUIRE(!result);
   }
 }
+
+TEST_CASE("One byte parser at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x2_b};
+
+  static_assert(one_byte(0x1_b)(data)->second.size() == 1);
+  static_assert(!one_byte(0x2_b)(data));
+}
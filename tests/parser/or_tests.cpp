@@ -47,3 +47,12 @@ TEST_CASE("Operator ||")
     REQUIRE(!result);
   }
 }
+
+TEST_CASE("Operator || at compile time")
+{
+  static constexpr auto data = std::array{0x2_b, 0x5_b};
+  constexpr auto parser = one_byte(0x01_b) || one_byte(0x02_b);
+
+  static_assert(parser(data)->first == 0x2_b);
+  static_assert(!parser(std::span(data).subspan(1)));
+}
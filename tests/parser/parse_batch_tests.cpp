@@ -0,0 +1,94 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "parse_it/batch.h"
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+TEST_CASE("Parse batch")
+{
+  const auto parser = combine(
+    [](std::byte, std::uint16_t value) { return value; }, one_byte(0x01_b), arithmetic_parser<std::uint16_t>());
+  auto messages = std::vector<std::vector<std::byte>>{};
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    const auto tag = i % 3 == 2 ? 0x02_b : 0x01_b;
+    messages.push_back({tag, static_cast<std::byte>(i >> 8), static_cast<std::byte>(i), 0xFF_b});
+  }
+  auto inputs = std::vector<parse_input_t>(messages.begin(), messages.end());
+
+  SUBCASE("parses every input and reports the successes.")
+  {
+    auto values = std::vector<std::uint16_t>(inputs.size());
+    const auto [success, rest] = parse_batch(parser, inputs, std::span(values));
+    REQUIRE(rest.empty());
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+      REQUIRE(success[i] == (i % 3 != 2));
+      if (success[i])
+      {
+        REQUIRE(values[i] == i);
+      }
+    }
+    REQUIRE(success.count() == 14);
+  }
+
+  SUBCASE("rejects inputs smaller than the parser minimum size.")
+  {
+    inputs[0] = inputs[0].first(2);
+    auto values = std::vector<std::uint16_t>(inputs.size());
+    const auto success = parse_batch(parser, inputs, std::span(values)).first;
+    REQUIRE_FALSE(success[0]);
+    REQUIRE(success[1]);
+  }
+
+  SUBCASE("stops at the end of the output.")
+  {
+    auto values = std::array<std::uint16_t, 5>{};
+    const auto [success, rest] = parse_batch(parser, inputs, std::span(values));
+    REQUIRE(success.count() == 4);
+    REQUIRE_FALSE(success[6]);
+    REQUIRE(rest.size() == 15);
+  }
+
+  SUBCASE("parses at most MAX_BATCH inputs and returns the others.")
+  {
+    auto values = std::vector<std::uint16_t>(inputs.size());
+    const auto [success, rest] = parse_batch<8>(parser, inputs, std::span(values));
+    REQUIRE(success.size() == 8);
+    REQUIRE(success.count() == 6);
+    REQUIRE(values[9] == 0);
+    REQUIRE(rest.size() == 12);
+    REQUIRE(rest.data() == inputs.data() + 8);
+  }
+
+  SUBCASE("parses larger batches through the returned inputs.")
+  {
+    auto values = std::vector<std::uint16_t>(inputs.size());
+    auto remaining = std::span<const parse_input_t>{inputs};
+    std::size_t parsed = 0;
+    while (!remaining.empty())
+    {
+      const auto first = inputs.size() - remaining.size();
+      const auto [success, rest] = parse_batch<8>(parser, remaining, std::span(values).subspan(first));
+      parsed += success.count();
+      remaining = rest;
+    }
+    REQUIRE(parsed == 14);
+    REQUIRE(values[19] == 19);
+  }
+
+  SUBCASE("handles empty batches.")
+  {
+    auto values = std::vector<std::uint16_t>{};
+    const auto [success, rest] = parse_batch(parser, {}, std::span(values));
+    REQUIRE(success.none());
+    REQUIRE(rest.empty());
+  }
+}
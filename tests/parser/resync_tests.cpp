@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+namespace {
+constexpr auto sync = std::array{0xAA_b, 0x55_b};
+// A frame: sync pattern, a value and a one byte trailer which must be 0xFF.
+constexpr auto frame = combine(
+  [](auto, std::uint8_t value, auto) { return value; }, byte_seq(sync), arithmetic_parser<std::uint8_t>(),
+  one_byte(0xFF_b));
+} // namespace
+
+TEST_CASE("Resync parser")
+{
+  constexpr auto parser = resync(sync, frame);
+
+  SUBCASE("parses a frame found right away without skipping bytes.")
+  {
+    constexpr auto data = std::array{0xAA_b, 0x55_b, 0x1_b, 0xFF_b, 0x0_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+    REQUIRE(result->first.value == 1);
+    REQUIRE(result->first.skipped.empty());
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("skips corrupted bytes and invalid candidates")
+  {
+    constexpr auto data = std::array{0x1_b, 0xAA_b, 0x2_b, 0xAA_b, 0x55_b, 0x3_b, 0x0_b, 0xAA_b, 0x55_b, 0x4_b, 0xFF_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+
+    SUBCASE("and returns the first valid frame.") { REQUIRE(result->first.value == 4); }
+
+    SUBCASE("and reports the skipped bytes.")
+    {
+      REQUIRE(result->first.skipped.data() == data.data());
+      REQUIRE(result->first.skipped.size() == 7);
+    }
+
+    SUBCASE("and consumes the frame.") { REQUIRE(result->second.empty()); }
+  }
+
+  SUBCASE("fails when no valid frame is found.")
+  {
+    constexpr auto data = std::array{0x1_b, 0xAA_b, 0x55_b, 0x3_b, 0x0_b, 0xAA_b};
+    REQUIRE(!parser(data));
+  }
+
+  SUBCASE("recovers every valid frame of a corrupted stream when repeated.")
+  {
+    constexpr auto data = std::array{0xAA_b, 0x55_b, 0x1_b, 0xFF_b, 0x55_b, 0xAA_b, 0x55_b, 0x2_b, 0xFF_b};
+    const auto frames = many(resync(sync, frame), std::vector<std::uint8_t>{}, [](auto values, auto resynced) {
+      values.push_back(resynced.value);
+      return values;
+    });
+    const auto result = frames(data);
+    REQUIRE(result);
+    REQUIRE(result->first == std::vector<std::uint8_t>{1, 2});
+  }
+}
+
+TEST_CASE("Resync parser at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0xAA_b, 0x55_b, 0x7_b, 0xFF_b};
+
+  static_assert(resync(sync, frame)(data)->first.value == 7);
+  static_assert(resync(sync, frame)(data)->first.skipped.size() == 1);
+}
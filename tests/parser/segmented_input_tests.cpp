@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+TEST_CASE("Segmented input")
+{
+  constexpr auto first = std::array{0x1_b, 0x2_b, 0x3_b};
+  constexpr auto second = std::array<std::byte, 0>{};
+  constexpr auto third = std::array{0x4_b, 0x5_b, 0x6_b, 0x7_b, 0x8_b};
+  const auto segments = std::array<parse_input_t, 3>{first, second, third};
+  const auto input = segmented_input{segments};
+
+  SUBCASE("spans every byte of its segments.") { REQUIRE(input.size() == 8); }
+
+  SUBCASE("skips empty segments when advancing.")
+  {
+    const auto remaining = input.subspan(3);
+    REQUIRE(remaining.size() == 5);
+    REQUIRE(std::ranges::equal(remaining.front_segment(), third));
+  }
+
+  SUBCASE("copies bytes across segment boundaries.")
+  {
+    auto copied = std::vector<std::byte>{};
+    input.subspan(2).copy(3, std::back_inserter(copied));
+    REQUIRE(copied == std::vector{0x3_b, 0x4_b, 0x5_b});
+  }
+
+  SUBCASE("limits the current segment to the view size.")
+  {
+    REQUIRE(input.first(2).front_segment().size() == 2);
+    REQUIRE(input.first(0).empty());
+  }
+}
+
+TEST_CASE("Arithmetic parser on segmented input")
+{
+  constexpr auto parser = arithmetic_parser<std::uint32_t>();
+  constexpr auto first = std::array{0x1_b, 0x2_b, 0x3_b, 0x4_b, 0x5_b, 0x6_b};
+  constexpr auto second = std::array{0x7_b, 0x8_b, 0x9_b};
+  const auto segments = std::array<parse_input_t, 2>{first, second};
+  const auto input = segmented_input{segments};
+
+  SUBCASE("reads values contained in one segment.")
+  {
+    const auto result = parser(input);
+    REQUIRE(result);
+    REQUIRE(result->first == 0x01020304);
+    REQUIRE(result->second.size() == 5);
+  }
+
+  SUBCASE("reads values crossing a segment boundary.")
+  {
+    const auto result = parser(input.subspan(4));
+    REQUIRE(result);
+    REQUIRE(result->first == 0x05060708);
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("fails if input is too small.") { REQUIRE(!parser(input.subspan(6))); }
+}
+
+TEST_CASE("Byte parsers on segmented input")
+{
+  constexpr auto first = std::array{0x1_b, 0x2_b};
+  constexpr auto second = std::array{0x3_b, 0x4_b, 0x5_b};
+  const auto segments = std::array<parse_input_t, 2>{first, second};
+  const auto input = segmented_input{segments};
+
+  SUBCASE("byte_seq matches a sequence crossing a segment boundary.")
+  {
+    const auto result = byte_seq(std::array{0x1_b, 0x2_b, 0x3_b})(input);
+    REQUIRE(result);
+    REQUIRE(result->second.size() == 2);
+    REQUIRE(!byte_seq(std::array{0x1_b, 0x2_b, 0x4_b})(input));
+  }
+
+  SUBCASE("n_bytes returns a view of the parsed bytes without copying them.")
+  {
+    const auto result = n_bytes(4)(input);
+    REQUIRE(result);
+    auto parsed = std::vector<std::byte>{};
+    result->first.copy(result->first.size(), std::back_inserter(parsed));
+    REQUIRE(parsed == std::vector{0x1_b, 0x2_b, 0x3_b, 0x4_b});
+    REQUIRE(result->second.size() == 1);
+    REQUIRE(!n_bytes(6)(input));
+  }
+
+  SUBCASE("one_byte, any_byte and skip consume a segmented input.")
+  {
+    REQUIRE(one_byte(0x1_b)(input));
+    REQUIRE(!one_byte(0x2_b)(input));
+    REQUIRE(any_byte()(input.subspan(2))->first == 0x3_b);
+    REQUIRE(skip(5)(input)->second.empty());
+    REQUIRE(!skip(6)(input));
+  }
+}
+
+TEST_CASE("Combined parsers on segmented input")
+{
+  struct header
+  {
+    std::uint8_t type;
+    std::uint16_t length;
+    std::uint32_t sequence;
+  };
+  const auto header_parser = fmap(
+    [](std::tuple<std::uint8_t, std::uint16_t, std::uint32_t> t) {
+      return header{std::get<0>(t), std::get<1>(t), std::get<2>(t)};
+    },
+    combine(
+      [](auto... values) { return std::tuple{values...}; },
+      arithmetic_parser<std::uint8_t>(),
+      arithmetic_parser<std::uint16_t>(),
+      arithmetic_parser<std::uint32_t>()));
+  constexpr auto first = std::array{0x01_b, 0x00_b};
+  constexpr auto second = std::array{0x08_b, 0x00_b, 0x00_b};
+  constexpr auto third = std::array{0x00_b, 0x2A_b, 0xFF_b};
+  const auto segments = std::array<parse_input_t, 3>{first, second, third};
+  const auto input = segmented_input{segments};
+
+  SUBCASE("parses a message crossing segment boundaries.")
+  {
+    const auto result = header_parser(input);
+    REQUIRE(result);
+    REQUIRE(result->first.type == 0x01);
+    REQUIRE(result->first.length == 0x0008);
+    REQUIRE(result->first.sequence == 0x0000002A);
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("fails if one of the parsers fails.")
+  {
+    REQUIRE(!header_parser(input.subspan(2)));
+    REQUIRE(!combine([](auto, auto) { return 0; }, one_byte(0x01_b), one_byte(0x01_b))(input));
+  }
+
+  SUBCASE("is only provided when every parser returns the same value on both kinds of inputs.")
+  {
+    const auto with_n_bytes = combine([](auto, auto bytes) { return bytes.size(); }, any_byte(), n_bytes(2));
+    static_assert(!std::is_invocable_v<decltype(with_n_bytes), segmented_input>);
+    REQUIRE(with_n_bytes(parse_input_t{second})->first == 2);
+  }
+}
+
+namespace {
+constexpr auto first_segment = std::array{0x1_b, 0x2_b};
+constexpr auto second_segment = std::array{0x3_b, 0x4_b};
+constexpr auto segments = std::array<parse_input_t, 2>{first_segment, second_segment};
+} // namespace
+
+TEST_CASE("Segmented input at compile time")
+{
+  static_assert(segmented_input{segments}.size() == 4);
+  static_assert(arithmetic_parser<std::uint16_t>()(segmented_input{segments}.subspan(1))->first == 0x0203);
+  static_assert(byte_seq(std::array{0x2_b, 0x3_b})(segmented_input{segments}.subspan(1)));
+  static_assert(
+    combine(
+      [](std::uint8_t a, std::uint16_t b) { return a + b; },
+      arithmetic_parser<std::uint8_t>(),
+      arithmetic_parser<std::uint16_t>())(segmented_input{segments})
+      ->first
+    == 0x01 + 0x0203);
+}
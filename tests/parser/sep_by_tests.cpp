@@ -0,0 +1,41 @@
+#include <algorithm>
+#include <array>
+
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+TEST_CASE("Sep by parser")
+{
+  const auto parser =
+    sep_by(any_byte(), one_byte(','_b), 0, [](int acc, std::byte b) { return acc + std::to_integer<int>(b); });
+
+  SUBCASE("parses values separated by the separator.")
+  {
+    constexpr auto data = std::array{0x1_b, ','_b, 0x2_b, ','_b, 0x3_b, 0x4_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+    REQUIRE(result->first == 6);
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("does not consume a trailing separator.")
+  {
+    constexpr auto data = std::array{0x1_b, ','_b};
+    const auto result = parser(data);
+    REQUIRE(result);
+    REQUIRE(result->first == 1);
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("returns the initial value if the parser fails instantly.")
+  {
+    const auto result = parser(std::span<const std::byte>{});
+    REQUIRE(result);
+    REQUIRE(result->first == 0);
+  }
+}
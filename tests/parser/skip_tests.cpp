@@ -36,3 +36,11 @@ TEST_CASE("Skip parser")
     REQUIRE(!result);
   }
 }
+
+TEST_CASE("Skip parser at compile time")
+{
+  static constexpr auto data = std::array{0x1_b, 0x2_b, 0x3_b};
+
+  static_assert(skip(2)(data)->second.size() == 1);
+  static_assert(!skip(4)(data));
+}
@@ -0,0 +1,101 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "parse_it/layout.h"
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+namespace {
+using message_layout = record_layout<
+  column<std::uint16_t>,
+  length_prefixed<std::uint8_t>,
+  padding<1>,
+  column<std::uint32_t, std::endian::little>,
+  length_prefixed<std::uint16_t>,
+  column<std::uint8_t>>;
+
+constexpr auto message = std::array{
+  0x12_b, 0x34_b,                 // id
+  0x02_b, 0xAA_b, 0xBB_b,         // name
+  0x00_b,                         // padding
+  0x01_b, 0x02_b, 0x03_b, 0x04_b, // price
+  0x00_b, 0x01_b, 0xCC_b,         // payload
+  0x07_b,                         // flags
+  0xFF_b};
+} // namespace
+
+TEST_CASE("Record layout with length prefixed fields")
+{
+  SUBCASE("computes the minimum record size.") { REQUIRE(message_layout::size == 11); }
+
+  SUBCASE("computes the offsets from the previous length prefixed field.")
+  {
+    REQUIRE(message_layout::offsets == std::array<std::size_t, 6>{0, 2, 0, 1, 5, 0});
+    REQUIRE(message_layout::tail_size == 1);
+    REQUIRE_FALSE(message_layout::fixed_size);
+  }
+}
+
+TEST_CASE("Record view")
+{
+  SUBCASE("decodes fields on access.")
+  {
+    const auto view = view_of<message_layout>::make(message);
+    REQUIRE(view);
+    REQUIRE(view->size() == 14);
+    REQUIRE(view->get<0>() == 0x1234);
+    REQUIRE(view->get<3>() == 0x04030201);
+    REQUIRE(view->get<5>() == 0x07);
+
+    const auto name = view->get<1>();
+    REQUIRE(name.size() == 2);
+    REQUIRE(name[0] == 0xAA_b);
+    REQUIRE(name[1] == 0xBB_b);
+    const auto payload = view->get<4>();
+    REQUIRE(payload.size() == 1);
+    REQUIRE(payload[0] == 0xCC_b);
+  }
+
+  SUBCASE("rejects records whose length prefixes exceed the input.")
+  {
+    auto truncated = std::vector<std::byte>(message.begin(), message.end());
+    truncated[11] = 0x03_b;
+    REQUIRE_FALSE(view_of<message_layout>::make(truncated));
+    for (std::size_t size = 0; size < 14; ++size)
+    {
+      REQUIRE_FALSE(view_of<message_layout>::make(parse_input_t{message}.first(size)));
+    }
+  }
+
+  SUBCASE("is parsed as a whole record.")
+  {
+    const auto parser = view_parser<message_layout>();
+    const auto result = parser(message);
+    REQUIRE(result);
+    REQUIRE(result->first.get<0>() == 0x1234);
+    REQUIRE(result->second.size() == 1);
+  }
+
+  SUBCASE("works with fixed size layouts.")
+  {
+    using layout = record_layout<column<std::uint8_t>, padding<1>, column<std::uint16_t>>;
+    const auto view = view_of<layout>::make(message);
+    REQUIRE(view);
+    REQUIRE(view->size() == 4);
+    REQUIRE(view->get<2>() == 0x02AA);
+  }
+}
+
+TEST_CASE("Record view at compile time")
+{
+  constexpr auto view = view_of<message_layout>::make(message);
+  static_assert(view && view->get<3>() == 0x04030201 && view->get<4>().size() == 1);
+  static_assert(!view_of<message_layout>::make(parse_input_t{message}.first(13)));
+  REQUIRE(view->get<5>() == 0x07);
+}
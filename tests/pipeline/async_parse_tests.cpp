@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "parse_it/async.h"
+#include "parse_it/parser.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+namespace {
+
+// A connection handler parsing length prefixed messages until the channel is closed.
+parse_task<std::size_t> handle_connection(byte_channel& channel, std::vector<std::uint16_t>& values)
+{
+  constexpr auto message = combine(
+    [](std::uint8_t, std::uint16_t value) { return value; }, arithmetic_parser<std::uint8_t>(),
+    arithmetic_parser<std::uint16_t>());
+  std::size_t count = 0;
+  while (auto value = co_await async_parse(channel, message, 3))
+  {
+    values.push_back(*value);
+    ++count;
+  }
+  co_return count;
+}
+
+} // namespace
+
+TEST_CASE("Async parse")
+{
+  auto channel = byte_channel{};
+  auto task = async_parse(channel, arithmetic_parser<std::uint32_t>(), 4);
+
+  SUBCASE("suspends until enough bytes are available")
+  {
+    REQUIRE(!task.done());
+    channel.push(std::array{0x1_b, 0x2_b});
+    REQUIRE(!task.done());
+    channel.push(std::array{0x3_b, 0x4_b, 0x5_b});
+    REQUIRE(task.done());
+
+    SUBCASE("and returns the parsed value.")
+    {
+      REQUIRE(task.result());
+      REQUIRE(*task.result() == 0x01020304);
+    }
+
+    SUBCASE("and consumes the parsed bytes from the source.") { REQUIRE(channel.available().size() == 1); }
+  }
+
+  SUBCASE("fails when the source is closed before a value is complete.")
+  {
+    channel.push(std::array{0x1_b});
+    channel.close();
+    REQUIRE(task.done());
+    REQUIRE(!task.result());
+  }
+}
+
+TEST_CASE("Async parse of a bounded input")
+{
+  auto channel = byte_channel{};
+  auto task = async_parse(channel, byte_seq(std::array{0x1_b, 0x2_b}), 2);
+
+  SUBCASE("fails once max_size bytes are available.")
+  {
+    channel.push(std::array{0x1_b, 0x3_b});
+    REQUIRE(task.done());
+    REQUIRE(!task.result());
+  }
+
+  SUBCASE("terminates on a malformed stream.")
+  {
+    for (int i = 0; i < 1000 && !task.done(); ++i)
+    {
+      channel.push(std::array{0xFF_b});
+    }
+    REQUIRE(task.done());
+    REQUIRE(!task.result());
+    REQUIRE(channel.available().size() == 2);
+  }
+}
+
+TEST_CASE("Async parse of a value referring to the input")
+{
+  auto channel = byte_channel{};
+  auto task = async_parse(channel, n_bytes(4), 4);
+  channel.push(std::array{0x1_b, 0x2_b});
+  channel.push(std::array{0x3_b, 0x4_b, 0x9_b, 0x9_b});
+  REQUIRE(task.done());
+
+  SUBCASE("returns the parsed bytes.")
+  {
+    const auto bytes = *task.result();
+    REQUIRE(std::ranges::equal(bytes, std::array{0x1_b, 0x2_b, 0x3_b, 0x4_b}));
+    REQUIRE(channel.available().size() == 2);
+  }
+
+  SUBCASE("keeps the parsed bytes valid while parsing the next value.")
+  {
+    const auto bytes = *task.result();
+    auto next = async_parse(channel, n_bytes(2), 2);
+    REQUIRE(next.done());
+    REQUIRE(std::ranges::equal(bytes, std::array{0x1_b, 0x2_b, 0x3_b, 0x4_b}));
+    REQUIRE(std::ranges::equal(*next.result(), std::array{0x9_b, 0x9_b}));
+  }
+}
+
+TEST_CASE("Async parse from a connection coroutine")
+{
+  auto channel = byte_channel{};
+  auto values = std::vector<std::uint16_t>{};
+  auto connection = handle_connection(channel, values);
+
+  channel.push(std::array{0x0_b, 0x0_b, 0x1_b, 0x0_b});
+  channel.push(std::array{0x0_b});
+  REQUIRE(values == std::vector<std::uint16_t>{1});
+  channel.push(std::array{0x2_b, 0x0_b, 0x0_b, 0x3_b});
+  REQUIRE(values == std::vector<std::uint16_t>{1, 2, 3});
+  REQUIRE(!connection.done());
+
+  channel.close();
+  REQUIRE(connection.done());
+  REQUIRE(*connection.result() == 3);
+}
+
+TEST_CASE("Async parse dropped while suspended")
+{
+  auto channel = byte_channel{};
+
+  SUBCASE("is not resumed by the source.")
+  {
+    {
+      auto task = async_parse(channel, arithmetic_parser<std::uint32_t>(), 4);
+      channel.push(std::array{0x1_b});
+      REQUIRE(!task.done());
+    }
+    channel.push(std::array{0x2_b, 0x3_b, 0x4_b});
+    channel.close();
+    REQUIRE(channel.available().size() == 4);
+  }
+
+  SUBCASE("from a connection coroutine is not resumed by the source.")
+  {
+    auto values = std::vector<std::uint16_t>{};
+    {
+      auto connection = handle_connection(channel, values);
+      channel.push(std::array{0x0_b, 0x0_b, 0x1_b, 0x0_b});
+      REQUIRE(values == std::vector<std::uint16_t>{1});
+    }
+    channel.push(std::array{0x0_b, 0x2_b});
+    channel.close();
+    REQUIRE(values == std::vector<std::uint16_t>{1});
+  }
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "parse_it/parser.h"
+#include "parse_it/spsc_ring.h"
+#include "parse_it/utils/byte_litterals.h"
+
+#include <doctest/doctest.h>
+
+using namespace parse_it;
+using namespace parse_it::byte_litterals;
+
+TEST_CASE("SPSC ring")
+{
+  auto ring = std::make_unique<spsc_ring<8>>();
+  constexpr auto parser = arithmetic_parser<std::uint16_t>();
+
+  SUBCASE("only exposes published bytes.")
+  {
+    constexpr auto data = std::array{0x1_b, 0x2_b, 0x3_b};
+    REQUIRE(ring->write(data) == 3);
+    REQUIRE(ring->readable().empty());
+    ring->publish();
+    REQUIRE(std::ranges::equal(ring->readable(), data));
+  }
+
+  SUBCASE("applies backpressure when full.")
+  {
+    const auto data = std::vector<std::byte>(10, 0x1_b);
+    REQUIRE(ring->write(data) == 8);
+    REQUIRE(ring->stats().producer_stalls == 1);
+  }
+
+  SUBCASE("drains complete records and keeps partial ones.")
+  {
+    constexpr auto data = std::array{0x0_b, 0x1_b, 0x0_b, 0x2_b, 0x0_b};
+    ring->write(data);
+    ring->publish();
+    auto values = std::vector<std::uint16_t>{};
+    REQUIRE(ring->drain(parser, [&](auto v) { values.push_back(v); }) == 2);
+    REQUIRE(values == std::vector<std::uint16_t>{1, 2});
+    REQUIRE(ring->readable().size() == 1);
+  }
+
+  SUBCASE("exposes records wrapping around the end of the ring contiguously.")
+  {
+    constexpr auto data = std::array{0x0_b, 0x1_b, 0x0_b, 0x2_b, 0x0_b, 0x3_b, 0x0_b};
+    ring->write(data);
+    ring->publish();
+    ring->drain(parser, [](auto) {});
+    constexpr auto next = std::array{0x4_b, 0x0_b, 0x5_b};
+    REQUIRE(ring->write(next) == 3);
+    ring->publish();
+    auto values = std::vector<std::uint16_t>{};
+    REQUIRE(ring->drain(parser, [&](auto v) { values.push_back(v); }) == 2);
+    REQUIRE(values == std::vector<std::uint16_t>{4, 5});
+    REQUIRE(ring->readable().empty());
+  }
+}
+
+TEST_CASE("SPSC ring between two threads")
+{
+  auto ring = std::make_unique<spsc_ring<64>>();
+  constexpr auto parser = arithmetic_parser<std::uint32_t, std::endian::little>();
+  constexpr std::uint32_t count = 10000;
+
+  auto producer = std::thread([&] {
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+      const auto bytes = std::array{
+        static_cast<std::byte>(i), static_cast<std::byte>(i >> 8), static_cast<std::byte>(i >> 16),
+        static_cast<std::byte>(i >> 24)};
+      // Split records in two writes to exercise partial records.
+      ring->write_all(std::span(bytes).first(1));
+      ring->write_all(std::span(bytes).subspan(1));
+    }
+    ring->close();
+  });
+
+  std::uint64_t sum = 0;
+  std::uint32_t received = 0;
+  const auto remaining = ring->consume(parser, [&](std::uint32_t v) {
+    sum += v;
+    ++received;
+  });
+  producer.join();
+
+  REQUIRE(remaining.empty());
+  REQUIRE(received == count);
+  REQUIRE(sum == std::uint64_t{count} * (count - 1) / 2);
+  REQUIRE(ring->stats().records_parsed == count);
+}
+
+TEST_CASE("SPSC ring with a malformed stream")
+{
+  auto ring = std::make_unique<spsc_ring<8>>();
+  const auto junk = std::vector<std::byte>(32, 0xFF_b);
+
+  bool written = true;
+  auto producer = std::thread([&] {
+    written = ring->write_all(junk);
+    ring->close();
+  });
+
+  std::size_t received = 0;
+  const auto remaining = ring->consume(one_byte(0x1_b), [&](auto) { ++received; });
+  producer.join();
+
+  REQUIRE(received == 0);
+  REQUIRE(remaining.size() == 8);
+  REQUIRE(ring->aborted());
+  REQUIRE_FALSE(written);
+}